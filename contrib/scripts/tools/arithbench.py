@@ -0,0 +1,77 @@
+"""
+Compare the running times of the exact (rational) solvers between two
+builds of Gambit, for example one configured with GMP and one configured
+using --without-gmp.
+
+Usage: python arithbench.py BUILDDIR1 BUILDDIR2 [GAMEDIR]
+
+Each of gambit-lcp, gambit-lp, gambit-simpdiv and gambit-enummixed is
+run on each game in GAMEDIR (by default, contrib/games), and the times
+taken by the two builds are reported side by side.  Runs whose outputs
+differ between the two builds are flagged.
+"""
+
+import glob
+import os
+import subprocess
+import sys
+import time
+
+TOOLS = [ ("gambit-lcp", [ "-q" ], (".nfg", ".efg")),
+          ("gambit-lp", [ "-q" ], (".nfg", ".efg")),
+          ("gambit-simpdiv", [ "-q" ], (".nfg",)),
+          ("gambit-enummixed", [ "-q" ], (".nfg",)) ]
+
+TIMEOUT = 60.0
+
+def run(builddir, tool, args, game):
+    """
+    Runs the tool on the game, returning the elapsed time and output,
+    or None for the time if the run did not complete.
+    """
+    start = time.time()
+    try:
+        output = subprocess.check_output([ os.path.join(builddir, tool) ] +
+                                         args + [ game ],
+                                         stderr=subprocess.STDOUT,
+                                         timeout=TIMEOUT)
+    except (subprocess.CalledProcessError, subprocess.TimeoutExpired):
+        return None, None
+    return time.time() - start, output
+
+def fmt(t):
+    return "%8s" % "-" if t is None else "%8.3f" % t
+
+if __name__ == '__main__':
+    if len(sys.argv) < 3:
+        sys.stderr.write(__doc__)
+        sys.exit(1)
+    build1, build2 = sys.argv[1], sys.argv[2]
+    if len(sys.argv) > 3:
+        gamedir = sys.argv[3]
+    else:
+        gamedir = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                               "..", "..", "games")
+
+    total1, total2 = 0.0, 0.0
+    print("%-18s %-28s %8s %8s %7s" %
+          ("tool", "game", "build1", "build2", "ratio"))
+    for tool, args, suffixes in TOOLS:
+        for game in sorted(glob.glob(os.path.join(gamedir, "*"))):
+            if not game.endswith(suffixes):
+                continue
+            t1, out1 = run(build1, tool, args, game)
+            t2, out2 = run(build2, tool, args, game)
+            if t1 is not None and t2 is not None:
+                total1 += t1
+                total2 += t2
+                ratio = "%7.2f" % (t1 / max(t2, 1.0e-6))
+            else:
+                ratio = "%7s" % "-"
+            flag = "" if out1 == out2 else "  OUTPUT DIFFERS"
+            print("%-18s %-28s %s %s %s%s" %
+                  (tool, os.path.basename(game), fmt(t1), fmt(t2),
+                   ratio, flag))
+    print("%-18s %-28s %s %s %7.2f" %
+          ("total", "(completed runs)", fmt(total1), fmt(total2),
+           total1 / max(total2, 1.0e-6)))
@@ -0,0 +1,170 @@
+"""
+Check Gambit's binary game file format against the text formats.
+
+Usage: python binarycheck.py BUILDDIR [GAMEDIR]
+
+Each .nfg and .efg game in GAMEDIR (by default, contrib/games) is
+written in binary format by the gambit-convert in BUILDDIR, and read
+back and written as text.  The text must be identical to that written
+from the original file.  Each binary file is then truncated, and has
+bytes altered, at a number of places; every truncated file must be
+rejected with an error, and no damaged file may crash the program or
+cause it to hang.  Finally, a small file describing a tree far larger
+than the file itself must be rejected promptly, rather than the tree
+being built before the file is found to be truncated.  Exits with a
+nonzero status if any check fails.
+"""
+
+import glob
+import os
+import random
+import struct
+import subprocess
+import sys
+import tempfile
+import time
+
+TIMEOUT = 60.0
+
+# The number of places at which each binary file is truncated and
+# damaged, in addition to truncation immediately after each of the
+# first bytes
+DAMAGE_COUNT = 20
+
+# The oversized tree has an information set with this many actions,
+# referred to by this many nodes, and must be rejected within OVERSIZED_TIME
+OVERSIZED_ACTIONS = 10000
+OVERSIZED_NODES = 1000
+OVERSIZED_TIME = 5.0
+
+def convert(builddir, fmt, data, timeout=TIMEOUT):
+    """
+    Runs gambit-convert on the data, returning the exit status and
+    output; the status is None if the program did not finish.
+    """
+    with tempfile.NamedTemporaryFile(suffix=".game") as f:
+        f.write(data)
+        f.flush()
+        try:
+            proc = subprocess.run([ os.path.join(builddir, "gambit-convert"),
+                                    "-q", "-O", fmt, f.name ],
+                                  stdout=subprocess.PIPE,
+                                  stderr=subprocess.PIPE,
+                                  timeout=timeout)
+        except subprocess.TimeoutExpired:
+            return None, None
+    return proc.returncode, proc.stdout
+
+def check_game(builddir, game, rng):
+    """
+    Checks the round trip and the damaged copies of the game, returning
+    a list of the failures found.
+    """
+    failures = []
+    with open(game, "rb") as f:
+        original = f.read()
+    status, text = convert(builddir, "native", original)
+    if status != 0:
+        return [ "could not be read" ]
+    status, binary = convert(builddir, "binary", original)
+    if status != 0:
+        return [ "could not be written in binary format" ]
+    status, roundtrip = convert(builddir, "native", binary)
+    if status != 0:
+        failures.append("binary file could not be read")
+    elif roundtrip != text:
+        failures.append("text differs after round trip through binary")
+
+    places = list(range(1, min(len(binary), 16)))
+    places += [ rng.randrange(1, len(binary)) for i in range(DAMAGE_COUNT) ]
+    for place in places:
+        status, output = convert(builddir, "native", binary[:place])
+        if status is None:
+            failures.append("hangs when truncated to %d bytes" % place)
+        elif status == 0:
+            failures.append("accepted when truncated to %d bytes" % place)
+        elif status < 0:
+            failures.append("crashes when truncated to %d bytes" % place)
+
+    for i in range(DAMAGE_COUNT):
+        place = rng.randrange(len(binary))
+        damaged = bytearray(binary)
+        damaged[place] ^= 1 << rng.randrange(8)
+        status, output = convert(builddir, "native", bytes(damaged))
+        if status is None:
+            failures.append("hangs when byte %d is altered" % place)
+        elif status < 0:
+            failures.append("crashes when byte %d is altered" % place)
+    return failures
+
+def oversized_tree(header):
+    """
+    Returns a binary tree game, with the signature and version in
+    'header', in which the root's information set has OVERSIZED_ACTIONS
+    actions, and is referred to again by OVERSIZED_NODES nodes.  The file
+    ends there, though each of those nodes implies OVERSIZED_ACTIONS more.
+    """
+    def integer(value):  return struct.pack("<i", value)
+    def string(value):   return integer(len(value)) + value
+    data = header + integer(2) + string(b"") + string(b"")
+    # One player, with no outcomes
+    data += integer(1) + string(b"") + integer(0)
+    # The root, defining the information set, and with no outcome
+    data += b"p" + string(b"") + integer(1) + integer(1) + b"\x01"
+    data += string(b"") + integer(OVERSIZED_ACTIONS)
+    data += string(b"") * OVERSIZED_ACTIONS + integer(0)
+    # Nodes referring to the information set, each with no outcome
+    data += (b"p" + string(b"") + integer(1) + integer(1) + b"\x00" +
+             integer(0)) * OVERSIZED_NODES
+    return data
+
+def check_oversized(builddir, header):
+    """
+    Checks that the oversized tree is rejected promptly, returning a
+    list of the failures found.
+    """
+    start = time.time()
+    status, output = convert(builddir, "native", oversized_tree(header),
+                             timeout=OVERSIZED_TIME)
+    if status is None:
+        return [ "not rejected within %g seconds" % OVERSIZED_TIME ]
+    elif status == 0:
+        return [ "accepted" ]
+    elif status < 0:
+        return [ "crashes" ]
+    return [ ]
+
+if __name__ == '__main__':
+    if len(sys.argv) < 2:
+        sys.stderr.write(__doc__)
+        sys.exit(1)
+    builddir = sys.argv[1]
+    if len(sys.argv) > 2:
+        gamedir = sys.argv[2]
+    else:
+        gamedir = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                               "..", "..", "games")
+
+    # A fixed seed, so that failures can be reproduced
+    rng = random.Random(1)
+    checked, failed = 0, 0
+    for game in sorted(glob.glob(os.path.join(gamedir, "*"))):
+        if not game.endswith((".nfg", ".efg")):
+            continue
+        checked += 1
+        failures = check_game(builddir, game, rng)
+        if failures:
+            failed += 1
+            for failure in failures:
+                print("%s: %s" % (os.path.basename(game), failure))
+
+    # The signature and version are taken from a file written by the
+    # program, so that the check follows the current version of the format
+    status, binary = convert(builddir, "binary",
+                             b'NFG 1 R "" { "1" } { 1 }\n\n0\n')
+    failures = check_oversized(builddir, binary[:12])
+    for failure in failures:
+        print("oversized tree: %s" % failure)
+
+    print("%d games checked, %d with failures" % (checked, failed))
+    sys.exit(1 if failed or failures else 0)
@@ -23,6 +23,8 @@
 #ifndef LIBGAMBIT_BEHAV_H
 #define LIBGAMBIT_BEHAV_H
 
+#include <vector>
+
 #include "game.h"
 
 namespace Gambit {
@@ -36,6 +38,10 @@ protected:
   BehaviorSupportProfile m_support;
 
   mutable bool m_cacheValid;
+  // if nonempty when the cache is not valid, the only changes since the
+  // cache was last valid are to the probabilities at these information
+  // sets (indexed as in the game's flattened tree)
+  mutable std::vector<int> m_changedInfosets;
 
   // structures for storing cached data: nodes
   mutable Vector<T> m_realizProbs, m_beliefs, m_nvals, m_bvals;
@@ -48,6 +54,10 @@ protected:
   mutable DVector<T> m_actionValues;   // aka conditional payoffs
   mutable DVector<T> m_gripe;
 
+  // probabilities of all actions, and realization probabilities of all
+  // information sets, indexed as in the game's flattened tree
+  mutable Array<T> m_actionProbs, m_infosetProbs;
+
   const T &ActionValue(const GameAction &act) const 
     { return m_actionValues(act->GetInfoset()->GetPlayer()->GetNumber(),
 			    act->GetInfoset()->GetNumber(),
@@ -59,11 +69,23 @@ protected:
   
   /// @name Auxiliary functions for computation of interesting values
   //@{
-  void GetPayoff(GameTreeNodeRep *, const T &, int, T &) const;
-  
-  void ComputeSolutionDataPass2(const GameNode &node) const;
-  void ComputeSolutionDataPass1(const GameNode &node) const;
+  void ComputeSolutionDataPass2(void) const;
+  void ComputeSolutionDataPass1(void) const;
   void ComputeSolutionData(void) const;
+  void UpdateSolutionData(void) const;
+
+  void ComputeActionProbs(int p_infoset) const;
+  void ComputeBeliefs(int p_infoset) const;
+  void ComputeNodeValue(int p_node) const;
+  void ComputeActionValues(int p_infoset) const;
+  void ComputeInfosetValue(int p_infoset) const;
+
+  /// Record a change to the probabilities at information set (pl, iset)
+  void InvalidateInfoset(int pl, int iset) const;
+  /// Record a change to the a'th entry of the profile
+  void InvalidateEntry(int a) const;
+  /// Record a change to the probabilities at a flattened information set
+  void RecordChange(int p_infoset) const;
   //@}
 
   /// @name Converting mixed strategies to behavior
@@ -113,11 +135,11 @@ public:
   const T &operator()(int a, int b, int c) const
     { return DVector<T>::operator()(a, b, c); }
   T &operator()(int a, int b, int c) 
-    { Invalidate();  return DVector<T>::operator()(a, b, c); }
+    { InvalidateInfoset(a, b);  return DVector<T>::operator()(a, b, c); }
   const T &operator[](int a) const
     { return Array<T>::operator[](a); }
   T &operator[](int a)
-    { Invalidate();  return Array<T>::operator[](a); }
+    { InvalidateEntry(a);  return Array<T>::operator[](a); }
 
   MixedBehaviorProfile<T> &operator+=(const MixedBehaviorProfile<T> &x)
     { Invalidate();  DVector<T>::operator+=(x);  return *this; }
@@ -132,7 +154,8 @@ public:
   /// @name Initialization, validation
   //@{
   /// Force recomputation of stored quantities
-  void Invalidate(void) const { m_cacheValid = false; }
+  void Invalidate(void) const
+    { m_cacheValid = false; m_changedInfosets.clear(); }
   /// Set the profile to the centroid
   void SetCentroid(void);
   /// Set the behavior at any undefined information set to the centroid
@@ -177,7 +200,17 @@ public:
 		  const GameAction &oppAction) const;
 
   MixedStrategyProfile<T> ToMixedProfile(void) const;
+  //@}
 
+  /// @name Incremental evaluation
+  //@{
+  /// \brief Sets the behavior strategy of one player
+  ///
+  /// Sets the player's action probabilities, given in the order of
+  /// the player's entries in the profile, and returns the payoffs to
+  /// all players.  Only the subtrees and information sets affected by
+  /// the player's information sets are reevaluated.
+  Vector<T> SetPlayerStrategy(int pl, const Vector<T> &p_probs);
   //@}
 };
 
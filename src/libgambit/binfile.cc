@@ -0,0 +1,223 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/libgambit/binfile.cc
+// Reading and writing the binary game file format
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <climits>
+#include <cstring>
+#include <iostream>
+
+#include "libgambit.h"
+#include "binfile.h"
+#include "gametable.h"
+#include "gametree.h"
+
+namespace Gambit {
+
+// The signature follows the PNG convention: a non-ASCII first byte, and
+// line endings and an end-of-file character which are mangled by text
+// mode transfers.
+const char BinaryFileMagic[BinaryFileMagicLength] =
+  { '\x89', 'G', 'B', 'G', '\r', '\n', '\x1a', '\n' };
+
+bool IsBinaryGameFile(const char *p_data, size_t p_length)
+{
+  return (p_length >= (size_t) BinaryFileMagicLength &&
+	  !memcmp(p_data, BinaryFileMagic, BinaryFileMagicLength));
+}
+
+namespace {
+
+// Tags distinguishing the ways in which a number is stored
+const unsigned char NUMBER_INTEGER = 0;   // canonical integer
+const unsigned char NUMBER_RATIONAL = 1;  // canonical numerator, denominator
+const unsigned char NUMBER_EXACT = 2;     // numerator, denominator, text
+const unsigned char NUMBER_TEXT = 3;      // text only
+
+bool FitsInInteger(const Integer &p_value)
+{
+  if (!p_value.fits_in_long())  return false;
+  long value = p_value.as_long();
+  return (value >= -INT_MAX && value <= INT_MAX);
+}
+
+}  // end anonymous namespace
+
+//========================================================================
+//                        class BinaryFileWriter
+//========================================================================
+
+void BinaryFileWriter::WriteHeader(BinaryGameKind p_kind, const GameRep &p_game)
+{
+  m_stream.write(BinaryFileMagic, BinaryFileMagicLength);
+  WriteInteger(BinaryFileVersion);
+  WriteInteger(p_kind);
+  WriteString(p_game.GetTitle());
+  WriteString(p_game.GetComment());
+}
+
+void BinaryFileWriter::WriteInteger(int p_value)
+{
+  unsigned int value = (unsigned int) p_value;
+  char bytes[4] = { (char) (value & 0xff), (char) ((value >> 8) & 0xff),
+		    (char) ((value >> 16) & 0xff), (char) ((value >> 24) & 0xff) };
+  m_stream.write(bytes, 4);
+}
+
+void BinaryFileWriter::WriteString(const std::string &p_value)
+{
+  WriteInteger(p_value.length());
+  m_stream.write(p_value.data(), p_value.length());
+}
+
+void BinaryFileWriter::WriteNumber(const Number &p_value)
+{
+  const Rational &rational = p_value;
+  const std::string &text = p_value;
+
+  if (!FitsInInteger(rational.numerator()) ||
+      !FitsInInteger(rational.denominator())) {
+    WriteByte(NUMBER_TEXT);
+    WriteString(text);
+  }
+  else if (text != lexical_cast<std::string>(rational)) {
+    WriteByte(NUMBER_EXACT);
+    WriteInteger(rational.numerator().as_long());
+    WriteInteger(rational.denominator().as_long());
+    WriteString(text);
+  }
+  else if (rational.denominator() == 1L) {
+    WriteByte(NUMBER_INTEGER);
+    WriteInteger(rational.numerator().as_long());
+  }
+  else {
+    WriteByte(NUMBER_RATIONAL);
+    WriteInteger(rational.numerator().as_long());
+    WriteInteger(rational.denominator().as_long());
+  }
+}
+
+//========================================================================
+//                        class BinaryFileReader
+//========================================================================
+
+BinaryGameKind BinaryFileReader::ReadHeader(void)
+{
+  Require(BinaryFileMagicLength);
+  if (memcmp(m_current, BinaryFileMagic, BinaryFileMagicLength)) {
+    throw InvalidFileException("Not a binary game file");
+  }
+  m_current += BinaryFileMagicLength;
+
+  if ((unsigned int) ReadInteger() != BinaryFileVersion) {
+    throw InvalidFileException("Unsupported version of binary game file");
+  }
+  int kind = ReadInteger();
+  if (kind != BINARY_TABLE && kind != BINARY_TREE) {
+    throw InvalidFileException("Unknown kind of game in binary game file");
+  }
+  return (BinaryGameKind) kind;
+}
+
+int BinaryFileReader::ReadIndex(int p_max)
+{
+  int value = ReadInteger();
+  if (value < 0 || value > p_max) {
+    throw InvalidFileException("Index out of range in binary game file");
+  }
+  return value;
+}
+
+int BinaryFileReader::ReadCount(size_t p_size)
+{
+  int value = ReadInteger();
+  if (value < 0 || (size_t) value > Remaining() / p_size) {
+    throw InvalidFileException("Count out of range in binary game file");
+  }
+  return value;
+}
+
+std::string BinaryFileReader::ReadString(void)
+{
+  size_t length = ReadCount(1);
+  const char *start = reinterpret_cast<const char *>(m_current);
+  m_current += length;
+  return std::string(start, length);
+}
+
+Number BinaryFileReader::ReadNumber(void)
+{
+  switch (ReadByte()) {
+  case NUMBER_INTEGER:
+    return Number((long) ReadInteger());
+  case NUMBER_RATIONAL: {
+    int num = ReadInteger(), den = ReadInteger();
+    if (den <= 0) {
+      throw InvalidFileException("Invalid number in binary game file");
+    }
+    return Number(Rational(num, den));
+  }
+  case NUMBER_EXACT: {
+    int num = ReadInteger(), den = ReadInteger();
+    if (den <= 0) {
+      throw InvalidFileException("Invalid number in binary game file");
+    }
+    return Number(Rational(num, den), ReadString());
+  }
+  case NUMBER_TEXT:
+    try {
+      return Number(ReadString());
+    }
+    catch (ValueException &) {
+      throw InvalidFileException("Invalid number in binary game file");
+    }
+  default:
+    throw InvalidFileException("Invalid number in binary game file");
+  }
+}
+
+//========================================================================
+//            ReadBinaryGame: Read a game in binary format
+//========================================================================
+
+Game ReadBinaryGame(const char *p_data, size_t p_length)
+  throw (InvalidFileException)
+{
+  BinaryFileReader reader(p_data, p_length);
+  BinaryGameKind kind = reader.ReadHeader();
+  std::string title = reader.ReadString();
+  std::string comment = reader.ReadString();
+
+  Game game;
+  if (kind == BINARY_TABLE) {
+    game = GameTableRep::ReadBinaryFile(reader);
+  }
+  else {
+    game = GameTreeRep::ReadBinaryFile(reader);
+  }
+  if (!reader.AtEnd()) {
+    throw InvalidFileException("Unexpected data at end of binary game file");
+  }
+  game->SetTitle(title);
+  game->SetComment(comment);
+  return game;
+}
+
+}  // end namespace Gambit
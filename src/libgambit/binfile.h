@@ -0,0 +1,121 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/libgambit/binfile.h
+// Reading and writing the binary game file format
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef LIBGAMBIT_BINFILE_H
+#define LIBGAMBIT_BINFILE_H
+
+//
+// A binary game file consists of
+//   * the eight bytes of BinaryFileMagic;
+//   * the version of the format, currently BinaryFileVersion;
+//   * the kind of game, BINARY_TABLE or BINARY_TREE;
+//   * the title and comment of the game;
+//   * the body written by GameTableRep or GameTreeRep.
+// Integers are 32 bits, little-endian, regardless of the platform;
+// strings are an integer length followed by the characters.  Numbers
+// carry their exact value, so that reading a file never requires
+// parsing text, except for values too large to store in this way.
+//
+
+namespace Gambit {
+
+const int BinaryFileMagicLength = 8;
+extern const char BinaryFileMagic[BinaryFileMagicLength];
+const unsigned int BinaryFileVersion = 1;
+
+enum BinaryGameKind { BINARY_TABLE = 1, BINARY_TREE = 2 };
+
+/// Returns true if the data begin with the binary file signature
+bool IsBinaryGameFile(const char *p_data, size_t p_length);
+
+///
+/// Writes the elements of a binary game file to a stream
+///
+class BinaryFileWriter {
+private:
+  std::ostream &m_stream;
+
+public:
+  BinaryFileWriter(std::ostream &p_stream) : m_stream(p_stream) { }
+
+  /// Writes the signature, version, kind, title and comment of the game
+  void WriteHeader(BinaryGameKind, const GameRep &);
+
+  void WriteByte(unsigned char p_value) { m_stream.put(p_value); }
+  void WriteInteger(int p_value);
+  void WriteString(const std::string &);
+  void WriteNumber(const Number &);
+};
+
+///
+/// Reads the elements of a binary game file from a block of memory,
+/// which is not copied, and so must outlive the reader.  Every read is
+/// checked against the end of the block, so truncated or corrupt files
+/// raise an InvalidFileException rather than reading out of bounds.
+///
+class BinaryFileReader {
+private:
+  const unsigned char *m_current, *m_end;
+
+  void Require(size_t p_bytes) const
+  {
+    if ((size_t) (m_end - m_current) < p_bytes) {
+      throw InvalidFileException("Binary game file is truncated");
+    }
+  }
+
+public:
+  BinaryFileReader(const char *p_data, size_t p_length)
+    : m_current(reinterpret_cast<const unsigned char *>(p_data)),
+      m_end(reinterpret_cast<const unsigned char *>(p_data) + p_length)
+  { }
+
+  /// Reads and checks the signature and version, returning the kind
+  BinaryGameKind ReadHeader(void);
+
+  unsigned char ReadByte(void)
+  { Require(1); return *m_current++; }
+  int ReadInteger(void)
+  {
+    Require(4);
+    unsigned int value = ((unsigned int) m_current[0] |
+			  ((unsigned int) m_current[1] << 8) |
+			  ((unsigned int) m_current[2] << 16) |
+			  ((unsigned int) m_current[3] << 24));
+    m_current += 4;
+    return (int) value;
+  }
+  /// Reads an index, which must lie between zero and p_max
+  int ReadIndex(int p_max);
+  /// Reads a count of items, each of which occupies at least p_size
+  /// bytes of what remains in the file
+  int ReadCount(size_t p_size);
+  size_t Remaining(void) const { return m_end - m_current; }
+  std::string ReadString(void);
+  Number ReadNumber(void);
+
+  bool AtEnd(void) const { return m_current == m_end; }
+};
+
+}  // end namespace Gambit
+
+#endif  // LIBGAMBIT_BINFILE_H
@@ -25,8 +25,12 @@
 #include <iostream>
 #include <sstream>
 #include <map>
+#include <vector>
+#include <algorithm>
 
 #include "libgambit.h"
+#include "binfile.h"
+#include "parallel.h"
 
 namespace {
 // This anonymous namespace encapsulates the file-parsing code
@@ -43,229 +47,261 @@ typedef enum {
 //! including the nonsignificance of whitespace and the possibility of
 //! escaped-quotes within text labels.
 //!
+//! The parser scans the file in place in memory.  Numbers and symbols
+//! are not copied out of the buffer unless their text is asked for;
+//! GetLastNumber() converts integers and decimals directly from the
+//! buffer, so that the payoff tables of large games are read without
+//! building a string for each payoff.
+//!
 class GameParserState {
 private:
-  std::istream &m_file;
-
+  const char *m_start, *m_current, *m_end;
+  /// The start of the current line, from which columns are counted
+  const char *m_lineStart;
   int m_currentLine;
-  int m_currentColumn;
   GameFileToken m_lastToken;
-  std::string m_lastText;
+  /// The extent of the last number or symbol within the buffer
+  const char *m_tokenStart, *m_tokenEnd;
+  /// The text of the last token; for numbers and symbols, this is only
+  /// filled in when requested
+  mutable std::string m_lastText;
+  mutable bool m_lastTextValid;
 
-  void ReadChar(char& c);
-  void UnreadChar(void);
   void IncreaseLine(void);
+  GameFileToken SetToken(GameFileToken p_token, const char *p_start)
+  {
+    m_tokenStart = p_start;
+    m_tokenEnd = m_current;
+    m_lastTextValid = false;
+    return (m_lastToken = p_token);
+  }
+  void SkipDigits(void)
+  { while (m_current < m_end && isdigit(*m_current)) m_current++; }
+  void SkipExponent(void);
 
 public:
-  GameParserState(std::istream &p_file) :
-    m_file(p_file), m_currentLine(1), m_currentColumn(1) { }
+  /// Scans the text from p_start to p_end.  When this is part of a
+  /// larger file, p_line and p_lineStart give the number and the start
+  /// of the line on which p_start lies, for messages.
+  GameParserState(const char *p_start, const char *p_end,
+		  int p_line = 1, const char *p_lineStart = 0)
+    : m_start(p_start), m_current(p_start), m_end(p_end),
+      m_lineStart((p_lineStart) ? p_lineStart : p_start),
+      m_currentLine(p_line), m_lastToken(TOKEN_EOF),
+      m_tokenStart(p_start), m_tokenEnd(p_start), m_lastTextValid(true)
+  { }
 
   GameFileToken GetNextToken(void);
   GameFileToken GetCurrentToken(void) const { return m_lastToken; }
   int GetCurrentLine(void) const { return m_currentLine; }
-  int GetCurrentColumn(void) const { return m_currentColumn; }
+  int GetCurrentColumn(void) const
+  {
+    // Messages have always counted the attempt to read past the end
+    int column = m_current - m_lineStart + 1;
+    return (m_lastToken == TOKEN_EOF && m_current == m_end) ? column + 1 : column;
+  }
+  /// Returns the number of characters of the file consumed so far
+  int GetOffset(void) const { return m_current - m_start; }
+  const char *GetStart(void) const { return m_start; }
+  const char *GetEnd(void) const { return m_end; }
+  /// Returns the position in the text at which the last token begins
+  const char *GetTokenStart(void) const { return m_tokenStart; }
   std::string CreateLineMsg(const std::string &msg);
-  const std::string &GetLastText(void) const { return m_lastText; }
+  const std::string &GetLastText(void) const
+  {
+    if (!m_lastTextValid) {
+      m_lastText.assign(m_tokenStart, m_tokenEnd);
+      m_lastTextValid = true;
+    }
+    return m_lastText;
+  }
+  /// Returns the value of the last token, which must be a number
+  Number GetLastNumber(void) const;
+  /// Returns the value of the last token, which must be a number, as
+  /// an integer, in the manner of atoi()
+  int GetLastInteger(void) const;
 };
 
-void GameParserState::ReadChar(char& c)
-{
-  m_file.get(c);
-  m_currentColumn++;
-}
-
-void GameParserState::UnreadChar(void)
+void GameParserState::IncreaseLine(void)
 {
-  m_file.unget();
-  m_currentColumn--;
-}
-
-void GameParserState::IncreaseLine(void){
   m_currentLine++;
   // Reset column
-  m_currentColumn = 1;
+  m_lineStart = m_current + 1;
 }
 
-GameFileToken GameParserState::GetNextToken(void)
+void GameParserState::SkipExponent(void)
 {
-  char c = ' ';
-  if (m_file.eof()) {
-    return (m_lastToken = TOKEN_EOF);
+  // Skips the 'e', the sign of the exponent if any, and the digits of
+  // the exponent, of which there must be at least one
+  m_current++;
+  if (m_current < m_end && (*m_current == '+' || *m_current == '-')) {
+    m_current++;
+  }
+  if (m_current == m_end || !isdigit(*m_current)) {
+    throw InvalidFileException(CreateLineMsg("Invalid exponent in number"));
   }
+  SkipDigits();
+}
 
-  while (isspace(c)) {
-    ReadChar(c);
-    if (!m_file.good()) {
-      return (m_lastToken = TOKEN_EOF);
-    }
-    else if (c == '\n') {
+GameFileToken GameParserState::GetNextToken(void)
+{
+  while (m_current < m_end && isspace(*m_current)) {
+    if (*m_current == '\n') {
       IncreaseLine();
     }
+    m_current++;
   }
 
+  if (m_current == m_end) {
+    return SetToken(TOKEN_EOF, m_current);
+  }
+
+  const char *start = m_current;
+  char c = *m_current++;
+
   if (c == '{') {
-    return (m_lastToken = TOKEN_LBRACE);
+    return SetToken(TOKEN_LBRACE, start);
   }
   else if (c == '}') {
-    return (m_lastToken = TOKEN_RBRACE);
+    return SetToken(TOKEN_RBRACE, start);
   }
   else if (c == ',') {
-    return (m_lastToken = TOKEN_COMMA);
+    return SetToken(TOKEN_COMMA, start);
   }
   else if (isdigit(c) || c == '-' || c == '+') {
-    std::string buf;
-    buf += c;
-    ReadChar(c);
-
-    while (!m_file.eof() && m_file.good() && isdigit(c)) {
-      buf += c;
-      ReadChar(c);
-    }
-
-    if (m_file.eof() || !m_file.good()) {
-      m_lastText = buf;
-      return (m_lastToken = TOKEN_NUMBER);
-    }
-
-    if (c == '.') {
-      buf += c;
-      ReadChar(c);
-      while (isdigit(c)) {
-        buf += c;
-        ReadChar(c);
-      }
-
-      if (c == 'e' || c == 'E') {
-        buf += c;
-        ReadChar(c);
-        if (c == '+' && c == '-' && !isdigit(c)) {
-          throw InvalidFileException(CreateLineMsg("Invalid Token +/-"));
-        }
-        buf += c;
-        ReadChar(c);
-        while (isdigit(c)) {
-          buf += c;
-          ReadChar(c);
-        }
-      }
-
-      UnreadChar();
-      m_lastText = buf;
-
-      return (m_lastToken = TOKEN_NUMBER);
-    }
-    else if (c == '/') {
-      buf += c;
-      ReadChar(c);
-      while (isdigit(c)) {
-        buf += c;
-        ReadChar(c);
+    SkipDigits();
+    if (m_current < m_end) {
+      if (*m_current == '.') {
+	m_current++;
+	SkipDigits();
+	if (m_current < m_end && (*m_current == 'e' || *m_current == 'E')) {
+	  SkipExponent();
+	}
       }
-      UnreadChar();
-      m_lastText = buf;
-      return (m_lastToken = TOKEN_NUMBER);
-    }
-    else if (c == 'e' || c == 'E') {
-      buf += c;
-      ReadChar(c);
-      if (c == '+' && c == '-' && !isdigit(c)) {
-        throw InvalidFileException(CreateLineMsg("Invalid Token +/-"));
+      else if (*m_current == '/') {
+	m_current++;
+	SkipDigits();
       }
-      buf += c;
-      ReadChar(c);
-      while (isdigit(c)) {
-        buf += c;
-        ReadChar(c);
+      else if (*m_current == 'e' || *m_current == 'E') {
+	SkipExponent();
       }
-      UnreadChar();
-      m_lastText = buf;
-      return (m_lastToken = TOKEN_NUMBER);
-    }
-    else {
-      UnreadChar();
-      m_lastText = buf;
-      return (m_lastToken = TOKEN_NUMBER);
     }
+    return SetToken(TOKEN_NUMBER, start);
   }
   else if (c == '.') {
-    std::string buf;
-    buf += c;
-    ReadChar(c);
-
-    while (isdigit(c)) {
-      buf += c;
-      ReadChar(c);
-    }
-    UnreadChar();
-    m_lastText = buf;
-    return (m_lastToken = TOKEN_NUMBER);
+    SkipDigits();
+    return SetToken(TOKEN_NUMBER, start);
   }
-
   else if (c == '"') {
     // We need to do a little magic here, since escaped quotes inside
     // the string are treated as quotes (not end-of-string)
-    UnreadChar();
-    char a;
-
     m_lastText = "";
+    bool lastslash = false;
 
-    do  {
-      ReadChar(a);
+    while (true) {
+      if (m_current == m_end) {
+	throw InvalidFileException(CreateLineMsg("End of file encountered when reading string label"));
+      }
+      char a = *m_current;
+      if (a == '\"' && !lastslash) {
+	m_current++;
+	break;
+      }
       if (a == '\n') {
-        IncreaseLine();
+	IncreaseLine();
+      }
+      if (lastslash && a == '"') {
+	m_lastText += '"';
       }
-    } while (isspace(a));
+      else if (lastslash)  {
+	m_lastText += '\\';
+	m_lastText += a;
+      }
+      else if (a != '\\') {
+	m_lastText += a;
+      }
+      lastslash = (a == '\\');
+      m_current++;
+    }
 
-    if (a == '\"')  {
-      bool lastslash = false;
+    SetToken(TOKEN_TEXT, start);
+    m_lastTextValid = true;
+    return TOKEN_TEXT;
+  }
 
-      ReadChar(a);
-      while  (a != '\"' || lastslash)  {
-	if (m_file.eof() || !m_file.good())  {
-	  throw InvalidFileException(CreateLineMsg("End of file encountered when reading string label"));
-	}
-        if (lastslash && a == '"') {
-          m_lastText += '"';
-	}
-        else if (lastslash)  {
-          m_lastText += '\\';
-          m_lastText += a;
-        }
-        else if (a != '\\')
-          m_lastText += a;
+  while (m_current < m_end && !isspace(*m_current)) {
+    m_current++;
+  }
+  SetToken(TOKEN_SYMBOL, start);
+  // Messages about a symbol have always given the column following the
+  // space which ends it
+  if (m_current < m_end && *m_current != '\n') {
+    m_current++;
+  }
+  return TOKEN_SYMBOL;
+}
 
-        lastslash = (a == '\\');
-        ReadChar(a);
+Number GameParserState::GetLastNumber(void) const
+{
+  // Integers and decimals of up to nine digits are converted here;
+  // everything else, including fractions and exponents, is handed to
+  // the general conversion from text.
+  const char *p = m_tokenStart;
+  bool negative = (p < m_tokenEnd && *p == '-');
+  if (negative)  p++;
+  const char *digits = p;
+  long value = 0, denominator = 1;
+  int numDigits = 0;
+  bool point = false;
+
+  for (; p < m_tokenEnd; p++) {
+    if (*p >= '0' && *p <= '9') {
+      if (++numDigits > 9) {
+	return Number(GetLastText());
       }
+      value = 10 * value + (*p - '0');
+      if (point)  denominator *= 10;
     }
-    else  {
-      do  {
-      	m_lastText += a;
-        ReadChar(a);
-	if (m_file.eof() || !m_file.good())  {
-	  throw InvalidFileException(CreateLineMsg("End of file encountered when reading string label"));
-	}
-        if (a == '\n') {
-          IncreaseLine();
-        }
-      }  while (!isspace(a));
+    else if (*p == '.' && !point) {
+      point = true;
+    }
+    else {
+      return Number(GetLastText());
     }
-
-    return (m_lastToken = TOKEN_TEXT);
   }
 
-  m_lastText = "";
-  while (!isspace(c) && !m_file.eof()) {
-    m_lastText += c;
-    ReadChar(c);
+  if (numDigits == 0) {
+    return Number(GetLastText());
+  }
+  if (negative)  value = -value;
+  if (point) {
+    // The text of a decimal is never the canonical text of its value,
+    // so it is kept
+    return Number(Rational(value, denominator), GetLastText());
+  }
+  if (digits[0] == '0' && (negative || m_tokenEnd - digits > 1)) {
+    // Leading zeros, or negative zero: keep the text as written
+    return Number(GetLastText());
   }
-  return (m_lastToken = TOKEN_SYMBOL);
+  return Number(value);
+}
+
+int GameParserState::GetLastInteger(void) const
+{
+  const char *p = m_tokenStart;
+  bool negative = (p < m_tokenEnd && *p == '-');
+  if (negative || (p < m_tokenEnd && *p == '+'))  p++;
+  int value = 0;
+  for (; p < m_tokenEnd && *p >= '0' && *p <= '9'; p++) {
+    value = 10 * value + (*p - '0');
+  }
+  return (negative) ? -value : value;
 }
 
 std::string GameParserState::CreateLineMsg(const std::string &msg)
 {
   std::stringstream stream;
-  stream << "line " << m_currentLine << ":" << m_currentColumn << ": " << msg;
+  stream << "line " << GetCurrentLine() << ":" << GetCurrentColumn() << ": " << msg;
   return stream.str();
 }
 
@@ -454,7 +490,7 @@ void ReadStrategies(GameParserState &p_state, TableFileGame &p_data)
           "Not enough players for number of strategy entries"));
       }
 
-      for (int st = 1; st <= atoi(p_state.GetLastText().c_str()); st++) {
+      for (int st = 1; st <= p_state.GetLastInteger(); st++) {
         player->m_strategies.Append(lexical_cast<std::string>(st));
       }
 
@@ -548,7 +584,7 @@ void ReadOutcomeList(GameParserState &p_parser, GameRep *p_nfg)
 
     try {
       while (p_parser.GetCurrentToken() == TOKEN_NUMBER) {
-        outcome->SetPayoff(pl++, p_parser.GetLastText());
+        outcome->SetPayoff(pl++, p_parser.GetLastNumber());
         if (p_parser.GetNextToken() == TOKEN_COMMA) {
             p_parser.GetNextToken();
         }
@@ -588,7 +624,7 @@ void ParseOutcomeBody(GameParserState &p_parser, GameRep *p_nfg)
         p_parser.CreateLineMsg("Expecting outcome index"));
     }
 
-    int outcomeId = atoi(p_parser.GetLastText().c_str());
+    int outcomeId = p_parser.GetLastInteger();
     if (outcomeId > 0)  {
       (*iter)->SetOutcome(p_nfg->GetOutcome(outcomeId));
     }
@@ -600,21 +636,191 @@ void ParseOutcomeBody(GameParserState &p_parser, GameRep *p_nfg)
   }
 }
 
+//
+// The payoff body of a large file is divided at whitespace into chunks,
+// which are converted to numbers on separate threads.  The payoffs are
+// then stored in the game chunk by chunk, in order, on the calling
+// thread, since game objects are not thread-safe.  A chunk which does
+// not convert cleanly is scanned again, as part of the whole file, so
+// that the error is reported at the same line and column as if the
+// file had been read serially.
+//
+class PayoffBodyTask : public ParallelTask {
+private:
+  struct Chunk {
+    const char *m_start, *m_end;
+    std::vector<Number> m_payoffs;
+    /// The number of lines ended within the chunk
+    int m_lines;
+    /// Set if the chunk ends at a token which is not a number
+    bool m_invalid;
+    /// Set, with the message, if converting a number failed
+    bool m_failed;
+    std::string m_error;
+
+    Chunk(void) : m_start(0), m_end(0), m_lines(0),
+		  m_invalid(false), m_failed(false) { }
+  };
+
+  /// Chunks are at least this long, so small files are read serially
+  static const size_t MinChunkLength = 1 << 18;
+
+  GameRep *m_nfg;
+  const char *m_fileStart, *m_bodyEnd;
+  std::vector<Chunk> m_chunks;
+  /// The line on which the next chunk to be stored starts, and the
+  /// outcome and player whose payoff is to be stored next
+  int m_line, m_outcome, m_player;
+  GameOutcome m_current;
+
+  void Fail(int p_piece, int p_token, const std::string &p_message) const;
+
+public:
+  PayoffBodyTask(GameRep *p_nfg, const GameParserState &p_parser);
+
+  int NumPieces(void) const { return m_chunks.size(); }
+  void Run(int p_piece);
+  bool Finish(int p_piece);
+};
+
+PayoffBodyTask::PayoffBodyTask(GameRep *p_nfg,
+			       const GameParserState &p_parser)
+  : m_nfg(p_nfg), m_fileStart(p_parser.GetStart()),
+    m_bodyEnd(p_parser.GetEnd()), m_line(p_parser.GetCurrentLine()),
+    m_outcome(1), m_player(1)
+{
+  // The body starts at the current token, which is its first payoff
+  const char *start = p_parser.GetTokenStart();
+  size_t length = m_bodyEnd - start;
+  // With only one processor, the body is left as one piece, and is
+  // read serially by ParsePayoffBody()
+  size_t pieces = 1;
+  if (GetDefaultThreads() > 1) {
+    pieces = std::min((size_t) (4 * GetDefaultThreads()),
+		      std::max(length / MinChunkLength, (size_t) 1));
+  }
+
+  m_chunks = std::vector<Chunk>(pieces);
+  for (size_t i = 0; i < pieces; i++) {
+    m_chunks[i].m_start = start;
+    if (i + 1 < pieces) {
+      const char *end = m_chunks[0].m_start + (i + 1) * (length / pieces);
+      if (end < start)  end = start;
+      while (end < m_bodyEnd && !isspace(*end))  end++;
+      start = end;
+    }
+    else {
+      start = m_bodyEnd;
+    }
+    m_chunks[i].m_end = start;
+  }
+}
+
+void PayoffBodyTask::Run(int p_piece)
+{
+  Chunk &chunk = m_chunks[p_piece];
+  // Counting the tokens first saves growing the array of payoffs
+  size_t tokens = 0;
+  bool space = true;
+  for (const char *p = chunk.m_start; p < chunk.m_end; p++) {
+    if (space && !isspace(*p))  tokens++;
+    space = isspace(*p);
+  }
+  chunk.m_payoffs.reserve(tokens);
+
+  GameParserState parser(chunk.m_start, chunk.m_end);
+  try {
+    while (parser.GetNextToken() == TOKEN_NUMBER) {
+      chunk.m_payoffs.push_back(parser.GetLastNumber());
+    }
+    chunk.m_invalid = (parser.GetCurrentToken() != TOKEN_EOF);
+  }
+  catch (InvalidFileException &) {
+    // A label running past the end of the chunk; this is reported
+    // when the chunk is scanned again
+    chunk.m_invalid = true;
+  }
+  catch (std::exception &ex) {
+    chunk.m_failed = true;
+    chunk.m_error = ex.what();
+  }
+  chunk.m_lines = parser.GetCurrentLine() - 1;
+}
+
+bool PayoffBodyTask::Finish(int p_piece)
+{
+  Chunk &chunk = m_chunks[p_piece];
+  for (size_t i = 0; i < chunk.m_payoffs.size(); i++) {
+    if (m_player == 1) {
+      if (m_outcome > m_nfg->NumOutcomes()) {
+	Fail(p_piece, i, "More payoffs than contingencies");
+      }
+      m_current = m_nfg->GetOutcome(m_outcome);
+    }
+    m_current->SetPayoff(m_player, chunk.m_payoffs[i]);
+    if (++m_player > m_nfg->NumPlayers()) {
+      m_outcome++;
+      m_player = 1;
+    }
+  }
+
+  if (chunk.m_invalid) {
+    Fail(p_piece, chunk.m_payoffs.size(), "Expecting payoff");
+  }
+  else if (chunk.m_failed) {
+    throw InvalidFileException(chunk.m_error);
+  }
+
+  std::vector<Number>().swap(chunk.m_payoffs);
+  m_line += chunk.m_lines;
+  return true;
+}
+
+void PayoffBodyTask::Fail(int p_piece, int p_token,
+			  const std::string &p_message) const
+{
+  const Chunk &chunk = m_chunks[p_piece];
+  const char *lineStart = chunk.m_start;
+  while (lineStart > m_fileStart && lineStart[-1] != '\n') {
+    lineStart--;
+  }
+
+  GameParserState parser(chunk.m_start, m_bodyEnd, m_line, lineStart);
+  for (int i = 0; i <= p_token; i++) {
+    parser.GetNextToken();
+  }
+  throw InvalidFileException(parser.CreateLineMsg(p_message));
+}
+
 void ParsePayoffBody(GameParserState &p_parser, GameRep *p_nfg)
 {
-  StrategyProfileIterator iter(StrategySupportProfile(static_cast<GameRep *>(p_nfg)));
-  int pl = 1;
+  PayoffBodyTask task(p_nfg, p_parser);
+  if (task.NumPieces() > 1) {
+    RunParallel(task, task.NumPieces());
+    return;
+  }
+
+  // A new table has one outcome for each contingency, numbered in the
+  // order in which the contingencies are listed in the file
+  int numPlayers = p_nfg->NumPlayers();
+  int outc = 1, pl = 1;
+  GameOutcome outcome;
 
   while (p_parser.GetCurrentToken() != TOKEN_EOF) {
-    if (p_parser.GetCurrentToken() == TOKEN_NUMBER) {
-      (*iter)->GetOutcome()->SetPayoff(pl, p_parser.GetLastText());
-    }
-    else {
+    if (p_parser.GetCurrentToken() != TOKEN_NUMBER) {
       throw InvalidFileException(p_parser.CreateLineMsg("Expecting payoff"));
     }
+    if (pl == 1) {
+      if (outc > p_nfg->NumOutcomes()) {
+	throw InvalidFileException(
+	  p_parser.CreateLineMsg("More payoffs than contingencies"));
+      }
+      outcome = p_nfg->GetOutcome(outc);
+    }
+    outcome->SetPayoff(pl, p_parser.GetLastNumber());
 
-    if (++pl > p_nfg->NumPlayers()) {
-      iter++;
+    if (++pl > numPlayers) {
+      outc++;
       pl = 1;
     }
     p_parser.GetNextToken();
@@ -709,7 +915,7 @@ void ParseOutcome(GameParserState &p_state,
       p_state.CreateLineMsg("Expecting index of outcome"));
   }
 
-  int outcomeId = atoi(p_state.GetLastText().c_str());
+  int outcomeId = p_state.GetLastInteger();
   p_state.GetNextToken();
 
   if (p_state.GetCurrentToken() == TOKEN_TEXT) {
@@ -734,7 +940,7 @@ void ParseOutcome(GameParserState &p_state,
 
     for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
       if (p_state.GetCurrentToken() == TOKEN_NUMBER) {
-        outcome->SetPayoff(pl, p_state.GetLastText());
+        outcome->SetPayoff(pl, p_state.GetLastNumber());
       }
       else {
         throw InvalidFileException(
@@ -788,7 +994,7 @@ void ParseChanceNode(GameParserState &p_state,
     throw InvalidFileException(p_state.CreateLineMsg("Expecting infoset id"));
   }
 
-  int infosetId = atoi(p_state.GetLastText().c_str());
+  int infosetId = p_state.GetLastInteger();
   GameInfoset infoset;
   if (p_treeData.m_chanceInfosetMap.count(infosetId)) {
     infoset = p_treeData.m_chanceInfosetMap[infosetId];
@@ -866,7 +1072,7 @@ void ParsePersonalNode(GameParserState &p_state,
   if (p_state.GetNextToken() != TOKEN_NUMBER) {
     throw InvalidFileException(p_state.CreateLineMsg("Expecting player id"));
   }
-  int playerId = atoi(p_state.GetLastText().c_str());
+  int playerId = p_state.GetLastInteger();
   // This will throw an exception if the player ID is not valid
   GamePlayer player = p_game->GetPlayer(playerId);
   std::map<int, GameInfoset> &infosetMap = p_treeData.m_infosetMap[playerId];
@@ -874,7 +1080,7 @@ void ParsePersonalNode(GameParserState &p_state,
   if (p_state.GetNextToken() != TOKEN_NUMBER) {
     throw InvalidFileException(p_state.CreateLineMsg("Expecting infoset id"));
   }
-  int infosetId = atoi(p_state.GetLastText().c_str());
+  int infosetId = p_state.GetLastInteger();
   GameInfoset infoset;
   if (infosetMap.count(infosetId)) {
     infoset = infosetMap[infosetId];
@@ -1045,22 +1251,27 @@ Game GameXMLSavefile::GetGame(void) const
 }
 
 //=========================================================================
-//    ReadGame: Global visible function to read an .efg or .nfg file
+//    ReadGame: Global visible function to read an .efg or .nfg file,
+//              or a game file in binary format
 //=========================================================================
 
 Game ReadGame(std::istream &p_file) throw (InvalidFileException)
 {
   std::stringstream buffer;
   buffer << p_file.rdbuf();
+  const std::string data(buffer.str());
+
+  if (IsBinaryGameFile(data.data(), data.length())) {
+    return ReadBinaryGame(data.data(), data.length());
+  }
+
   try {
-    GameXMLSavefile doc(buffer.str());
+    GameXMLSavefile doc(data);
     return doc.GetGame();
   }
-  catch (InvalidFileException) {
-    buffer.seekg(0, std::ios::beg);
-  }
+  catch (InvalidFileException) { }
 
-  GameParserState parser(buffer);
+  GameParserState parser(data.data(), data.data() + data.length());
   try {
     if (parser.GetNextToken() != TOKEN_SYMBOL) {
       throw InvalidFileException(parser.CreateLineMsg("Expecting file type"));
@@ -1078,9 +1289,11 @@ Game ReadGame(std::istream &p_file) throw (InvalidFileException)
       return game;
     }
     else if (parser.GetLastText() == "#AGG") {
+      buffer.seekg(parser.GetOffset(), std::ios::beg);
       return GameAggRep::ReadAggFile(buffer);
     }
     else if (parser.GetLastText() == "#BAGG") {
+      buffer.seekg(parser.GetOffset(), std::ios::beg);
       return GameBagentRep::ReadBaggFile(buffer);
     }
     else {
@@ -161,6 +161,7 @@ class PureStrategyProfile;
 template <class T> class MixedStrategyProfile;
 template <class T> class MixedBehaviorProfile;
 class StrategySupportProfile;
+class GameTableRep;
 
 //=======================================================================
 //         Exceptions thrown from game representation classes
@@ -233,14 +234,12 @@ public:
   void SetLabel(const std::string &p_label) { m_label = p_label; }
 
   /// Gets the payoff associated with the outcome to player 'pl'
-  template <class T> const T &GetPayoff(int pl) const 
-    { return (const T &) m_payoffs[pl]; }
+  template <class T> T GetPayoff(int pl) const 
+    { return m_payoffs[pl]; }
   /// Sets the payoff to player 'pl'
-  void SetPayoff(int pl, const std::string &p_value)
-  {
-    m_payoffs[pl] = p_value;
-    //m_game->ClearComputedValues();
-  }
+  void SetPayoff(int pl, const std::string &p_value);
+  /// Sets the payoff to player 'pl'
+  void SetPayoff(int pl, const Number &p_value);
 
   /// Map the outcome to the corresponding outcome in the unrestricted game
   GameOutcome Unrestrict(void) const 
@@ -648,6 +647,7 @@ public:
 
 /// This is the class for representing an arbitrary finite game.
 class GameRep : public GameObject {
+  friend class GameOutcomeRep;
   friend class GameTreeInfosetRep;
   friend class GamePlayerRep;
   friend class GameTreeNodeRep;
@@ -672,6 +672,8 @@ protected:
   virtual void BuildComputedValues(void) { }
   /// Have computed values been built?
   virtual bool HasComputedValues(void) const { return false; }
+  /// Clear out any values computed from outcome payoffs
+  virtual void ClearComputedPayoffs(void) const { }
   //@}
 
 
@@ -814,6 +816,17 @@ Game NewTable(const Array<int> &p_dim, bool p_sparseOutcomes = false);
 // all classes to be defined.
 
 inline Game GameOutcomeRep::GetGame(void) const { return m_game; }
+inline void GameOutcomeRep::SetPayoff(int pl, const std::string &p_value)
+{
+  m_payoffs[pl] = p_value;
+  m_game->ClearComputedPayoffs();
+}
+
+inline void GameOutcomeRep::SetPayoff(int pl, const Number &p_value)
+{
+  m_payoffs[pl] = p_value;
+  m_game->ClearComputedPayoffs();
+}
 
 inline GamePlayer GameStrategyRep::GetPlayer(void) const { return m_player; }
 
@@ -837,8 +850,13 @@ template<> inline std::string PureBehaviorProfile::GetPayoff(int pl) const
 //=======================================================================
 
 
-/// Reads a game in .efg or .nfg format from the input stream
+/// Reads a game in .efg, .nfg or binary format from the input stream
 Game ReadGame(std::istream &) throw (InvalidFileException);
+/// Reads a game in binary format from a block of memory, such as a
+/// memory-mapped file.  Only the labels of the game are copied out of
+/// the block; the payoffs and outcomes are taken without parsing.
+Game ReadBinaryGame(const char *p_data, size_t p_length)
+  throw (InvalidFileException);
 
 } // end namespace gambit
 
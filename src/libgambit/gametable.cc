@@ -25,6 +25,7 @@
 
 #include "libgambit.h"
 #include "gametable.h"
+#include "binfile.h"
 
 namespace Gambit {
 
@@ -87,7 +88,9 @@ GameOutcome TablePureStrategyProfileRep::GetOutcome(void) const
 
 void TablePureStrategyProfileRep::SetOutcome(GameOutcome p_outcome)
 {
-  dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index] = p_outcome; 
+  GameTableRep &g = dynamic_cast<GameTableRep &>(*m_nfg);
+  g.m_results[m_index] = p_outcome; 
+  g.ClearComputedValues();
 }
 
 Rational TablePureStrategyProfileRep::GetPayoff(int pl) const
@@ -140,6 +143,8 @@ int Product(const Array<int> &dim)
   
 GameTableRep::GameTableRep(const Array<int> &dim, 
 			   bool p_sparseOutcomes /* = false */)
+  : m_doublePayoffsValid(false), m_rationalPayoffsValid(false),
+    m_payoffVersion(0)
 {
   m_results = Array<GameOutcomeRep *>(Product(dim));
   for (int pl = 1; pl <= dim.Length(); pl++)  {
@@ -251,7 +256,7 @@ void GameTableRep::WriteNfgFile(std::ostream &p_file) const
   for (int outc = 1; outc <= m_outcomes.Length(); outc++)   {
     p_file << "{ \"" << EscapeQuotes(m_outcomes[outc]->m_label) << "\" ";
     for (int pl = 1; pl <= m_players.Length(); pl++)  {
-      p_file << (const std::string &) m_outcomes[outc]->m_payoffs[pl];
+      p_file << (std::string) m_outcomes[outc]->m_payoffs[pl];
       
       if (pl < m_players.Length()) {
 	p_file << ", ";
@@ -275,6 +280,87 @@ void GameTableRep::WriteNfgFile(std::ostream &p_file) const
   p_file << '\n';
 }
 
+//
+// The body of a binary file gives the number of players and their
+// numbers of strategies, then the labels of the players and strategies,
+// then the outcomes, and finally the index of the outcome (or zero)
+// at each contingency, in the order used by m_results.
+//
+void GameTableRep::WriteBinaryFile(std::ostream &p_file) const
+{
+  BinaryFileWriter writer(p_file);
+  writer.WriteHeader(BINARY_TABLE, *this);
+
+  writer.WriteInteger(m_players.Length());
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    writer.WriteInteger(m_players[pl]->m_strategies.Length());
+  }
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    GamePlayerRep *player = m_players[pl];
+    writer.WriteString(player->m_label);
+    for (int st = 1; st <= player->m_strategies.Length(); st++) {
+      writer.WriteString(player->m_strategies[st]->m_label);
+    }
+  }
+
+  writer.WriteInteger(m_outcomes.Length());
+  for (int outc = 1; outc <= m_outcomes.Length(); outc++) {
+    writer.WriteString(m_outcomes[outc]->m_label);
+    for (int pl = 1; pl <= m_players.Length(); pl++) {
+      writer.WriteNumber(m_outcomes[outc]->m_payoffs[pl]);
+    }
+  }
+
+  for (int cont = 1; cont <= m_results.Length(); cont++) {
+    writer.WriteInteger((m_results[cont]) ? m_results[cont]->m_number : 0);
+  }
+}
+
+Game GameTableRep::ReadBinaryFile(BinaryFileReader &p_reader)
+{
+  // Each strategy has at least a label, and each contingency an outcome
+  // index, in the rest of the file, which bounds the size of the table
+  Array<int> dim(p_reader.ReadCount(4));
+  double contingencies = 1.0;
+  for (int pl = 1; pl <= dim.Length(); pl++) {
+    dim[pl] = p_reader.ReadCount(4);
+    contingencies *= dim[pl];
+  }
+  if (contingencies > (double) (p_reader.Remaining() / 4)) {
+    throw InvalidFileException("Binary game file is truncated");
+  }
+
+  GameTableRep *nfg = new GameTableRep(dim, true);
+  Game game = nfg;
+  for (int pl = 1; pl <= dim.Length(); pl++) {
+    GamePlayerRep *player = nfg->m_players[pl];
+    player->m_label = p_reader.ReadString();
+    for (int st = 1; st <= dim[pl]; st++) {
+      player->m_strategies[st]->m_label = p_reader.ReadString();
+    }
+  }
+
+  int numOutcomes = p_reader.ReadCount(4);
+  nfg->m_outcomes = Array<GameOutcomeRep *>(numOutcomes);
+  for (int outc = 1; outc <= numOutcomes; outc++) {
+    nfg->m_outcomes[outc] = new GameOutcomeRep(nfg, outc);
+  }
+  for (int outc = 1; outc <= numOutcomes; outc++) {
+    GameOutcomeRep *outcome = nfg->m_outcomes[outc];
+    outcome->m_label = p_reader.ReadString();
+    for (int pl = 1; pl <= dim.Length(); pl++) {
+      outcome->m_payoffs[pl] = p_reader.ReadNumber();
+    }
+  }
+
+  for (int cont = 1; cont <= nfg->m_results.Length(); cont++) {
+    int outc = p_reader.ReadIndex(numOutcomes);
+    nfg->m_results[cont] = (outc) ? nfg->m_outcomes[outc] : 0;
+  }
+  nfg->ClearComputedValues();
+  return game;
+}
+
 //------------------------------------------------------------------------
 //                       GameTableRep: Players
 //------------------------------------------------------------------------
@@ -284,6 +370,7 @@ GamePlayer GameTableRep::NewPlayer(void)
   GamePlayerRep *player = 0;
   player = new GamePlayerRep(this, m_players.Length() + 1, 1);
   m_players.Append(player);
+  m_tableDims.Append(1);
   for (int outc = 1; outc <= m_outcomes.Last(); outc++) {
     m_outcomes[outc]->m_payoffs.Append(Number());
   }
@@ -309,6 +396,29 @@ void GameTableRep::DeleteOutcome(const GameOutcome &p_outcome)
   ClearComputedValues();
 }
 
+//------------------------------------------------------------------------
+//                   GameTableRep: Dense payoff tables
+//------------------------------------------------------------------------
+
+template<> const double *GameTableRep::GetPayoffTable<double>(int pl) const
+{
+  if (!m_doublePayoffsValid) {
+    BuildPayoffTable(m_doublePayoffs);
+    m_doublePayoffsValid = true;
+  }
+  return &m_doublePayoffs[(pl - 1) * m_results.Length()];
+}
+
+template<> 
+const Rational *GameTableRep::GetPayoffTable<Rational>(int pl) const
+{
+  if (!m_rationalPayoffsValid) {
+    BuildPayoffTable(m_rationalPayoffs);
+    m_rationalPayoffsValid = true;
+  }
+  return &m_rationalPayoffs[(pl - 1) * m_results.Length()];
+}
+
 //------------------------------------------------------------------------
 //                   GameTableRep: Factory functions
 //------------------------------------------------------------------------
@@ -373,13 +483,32 @@ void GameTableRep::RebuildTable(void)
   m_results = newResults;
 
   IndexStrategies();
+  ClearComputedValues();
+}
+
+/// Fills p_table with the payoffs of each contingency, one player's
+/// block after another.  Contingencies with no outcome have payoff zero.
+template <class T>
+void GameTableRep::BuildPayoffTable(std::vector<T> &p_table) const
+{
+  long ncont = m_results.Length();
+  p_table.assign(m_players.Length() * ncont, (T) 0);
+  for (long cont = 1; cont <= ncont; cont++) {
+    GameOutcomeRep *outcome = m_results[cont];
+    if (!outcome) continue;
+    for (int pl = 1; pl <= m_players.Length(); pl++) {
+      p_table[(pl - 1) * ncont + cont - 1] = outcome->GetPayoff<T>(pl);
+    }
+  }
 }
 
 void GameTableRep::IndexStrategies(void)
 {
+  m_tableDims = Array<int>(m_players.Length());
   long offset = 1L;
   for (GamePlayers::const_iterator player = m_players.begin();
        player != m_players.end(); ++player)  {
+    m_tableDims[player->GetNumber()] = player->m_strategies.size();
     int st = 1;
     for (Array<GameStrategyRep *>::const_iterator strategy = player->m_strategies.begin();
 	 strategy != player->m_strategies.end(); ++st, ++strategy) {
@@ -23,10 +23,13 @@
 #ifndef GAMETABLE_H
 #define GAMETABLE_H
 
+#include <vector>
 #include "gameexpl.h"
 
 namespace Gambit {
 
+class BinaryFileReader;
+
 class GameTableRep : public GameExplicitRep {
   friend class StrategySupportProfile;
   friend class GamePlayerRep;
@@ -36,12 +39,35 @@ class GameTableRep : public GameExplicitRep {
   template <class T> friend class TableMixedStrategyProfileRep;
 private:
   Array<GameOutcomeRep *> m_results;
+  /// The extent of each player's axis in the table of outcomes
+  Array<int> m_tableDims;
   Game m_unrestricted;
 
+  /// @name Dense payoff tables
+  //@{
+  /// Payoffs for each contingency, stored player by player.  Within
+  /// each player's block, contingencies are ordered by the sum of the
+  /// strategy offsets, so the first player's strategies are adjacent.
+  mutable std::vector<double> m_doublePayoffs;
+  mutable std::vector<Rational> m_rationalPayoffs;
+  mutable bool m_doublePayoffsValid, m_rationalPayoffsValid;
+  /// Incremented whenever the payoffs may have changed, so that values
+  /// computed from them elsewhere can be recognized as out of date
+  mutable long m_payoffVersion;
+  //@}
+
   /// @name Private auxiliary functions
   //@{
   void IndexStrategies(void);
   void RebuildTable(void);
+  template <class T> void BuildPayoffTable(std::vector<T> &) const;
+  //@}
+
+  /// @name Managing the representation
+  //@{
+  virtual void ClearComputedValues(void) const { ClearComputedPayoffs(); }
+  virtual void ClearComputedPayoffs(void) const
+  { m_doublePayoffsValid = m_rationalPayoffsValid = false; m_payoffVersion++; }
   //@}
 
 public:
@@ -50,6 +76,8 @@ public:
   /// Construct a new table game with the given dimension
   /// If p_sparseOutcomes = true, outcomes for all contingencies are left null
   GameTableRep(const Array<int> &p_dim, bool p_sparseOutcomes = false);
+  /// Create a game from the body of a file in binary format
+  static Game ReadBinaryFile(BinaryFileReader &);
   virtual Game Copy(void) const;
   //@}
 
@@ -116,9 +144,25 @@ public:
   virtual void DeleteOutcome(const GameOutcome &);
   //@}
 
+  /// @name Dense payoff tables
+  //@{
+  /// \brief Returns the table of payoffs to player pl
+  ///
+  /// Returns a pointer to the payoffs to player pl, indexed by the
+  /// sum of the offsets of the strategies in a contingency (starting
+  /// from zero).  The tables of successive players are adjacent, so
+  /// the table of player 1 continues with the payoffs to all the other
+  /// players.  The table is built from the outcomes on first use, and
+  /// is rebuilt after any change to outcomes or payoffs.
+  template <class T> const T *GetPayoffTable(int pl) const;
+  /// Returns the extent of player pl's axis in the payoff tables
+  int GetTableDim(int pl) const { return m_tableDims[pl]; }
+  //@}
+
   /// @name Writing data files
   //@{
   virtual void WriteNfgFile(std::ostream &) const;
+  virtual void WriteBinaryFile(std::ostream &) const;
   //@}
 
   virtual PureStrategyProfile NewPureStrategyProfile(void) const;
@@ -129,6 +173,9 @@ public:
 
 };
 
+template<> const double *GameTableRep::GetPayoffTable<double>(int pl) const;
+template<> const Rational *GameTableRep::GetPayoffTable<Rational>(int pl) const;
+
 }
 
 
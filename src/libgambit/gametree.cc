@@ -22,9 +22,13 @@
 
 #include <iostream>
 #include <sstream>
+#include <vector>
+#include <map>
+#include <set>
 
 #include "libgambit.h"
 #include "gametree.h"
+#include "binfile.h"
 
 namespace Gambit {
 
@@ -550,6 +554,8 @@ GameInfoset GameTreeNodeRep::InsertMove(GameInfoset p_infoset)
 GameTreeRep::GameTreeRep(void)
 {
   m_computedValues = false;
+  m_flatValid = false;
+  m_numPersonalInfosets = 0;
   m_chance = new GamePlayerRep(this, 0);
   m_root = new GameTreeNodeRep(this, 0);
 }
@@ -739,6 +745,102 @@ void GameTreeRep::ClearComputedValues(void) const
   }
 
   m_computedValues = false;
+  m_flatValid = false;
+}
+
+void GameTreeRep::BuildFlatTree(void)
+{
+  if (m_flatValid) return;
+
+  // Collect the nodes, without recursion since trees may be deep
+  std::vector<GameTreeNodeRep *> order, stack;
+  stack.push_back(m_root);
+  while (!stack.empty()) {
+    GameTreeNodeRep *node = stack.back();
+    stack.pop_back();
+    order.push_back(node);
+    for (int i = node->children.Length(); i >= 1; i--) {
+      stack.push_back(node->children[i]);
+    }
+  }
+  int numNodes = order.size();
+  Array<GameTreeNodeRep *> nodes(numNodes);
+  for (int i = 0; i < numNodes; i++) {
+    nodes[order[i]->number] = order[i];
+  }
+
+  // Number information sets and actions globally
+  m_numPersonalInfosets = 0;
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    m_numPersonalInfosets += m_players[pl]->m_infosets.Length();
+  }
+  int numInfosets = m_numPersonalInfosets + m_chance->m_infosets.Length();
+  m_infosetPlayer = Array<int>(numInfosets + 1);
+  m_infosetFirstAction = Array<int>(numInfosets + 1);
+  m_infosetMemberStart = Array<int>(numInfosets + 1);
+  m_infosetMembers = Array<int>(numNodes);
+
+  // Maps (player, information set number) to the global index
+  Array<int> firstInfoset(m_players.Length() + 1);
+  int index = 1, action = 1, member = 1;
+  for (int i = 1; i <= m_players.Length() + 1; i++) {
+    int pl = (i <= m_players.Length()) ? i : 0;
+    GamePlayerRep *player = (pl) ? m_players[pl] : m_chance;
+    firstInfoset[i] = index;
+    for (int iset = 1; iset <= player->m_infosets.Length(); iset++, index++) {
+      GameTreeInfosetRep *infoset = player->m_infosets[iset];
+      m_infosetPlayer[index] = pl;
+      m_infosetFirstAction[index] = action;
+      action += infoset->m_actions.Length();
+      m_infosetMemberStart[index] = member;
+      for (int m = 1; m <= infoset->m_members.Length(); m++) {
+	m_infosetMembers[member++] = infoset->m_members[m]->number;
+      }
+    }
+  }
+  m_infosetPlayer[index] = 0;
+  m_infosetFirstAction[index] = action;
+  m_infosetMemberStart[index] = member;
+
+  m_nodeParent = Array<int>(numNodes);
+  m_nodePriorAction = Array<int>(numNodes);
+  m_nodeInfoset = Array<int>(numNodes);
+  m_nodeOutcome = Array<int>(numNodes);
+  m_nodeChildStart = Array<int>(numNodes + 1);
+  m_nodeChildren = Array<int>((numNodes > 1) ? numNodes - 1 : 0);
+
+  int child = 1;
+  for (int n = 1; n <= numNodes; n++) {
+    GameTreeNodeRep *node = nodes[n];
+    GameTreeInfosetRep *infoset = node->infoset;
+    m_nodeParent[n] = (node->m_parent) ? node->m_parent->number : 0;
+    m_nodeOutcome[n] = (node->outcome) ? node->outcome->m_number : 0;
+    m_nodeChildStart[n] = child;
+    if (infoset) {
+      int pl = infoset->m_player->m_number;
+      int iset = firstInfoset[(pl) ? pl : m_players.Length() + 1] +
+	infoset->m_number - 1;
+      m_nodeInfoset[n] = iset;
+      for (int i = 1; i <= node->children.Length(); i++) {
+	int c = node->children[i]->number;
+	m_nodeChildren[child++] = c;
+	m_nodePriorAction[c] = m_infosetFirstAction[iset] + i - 1;
+      }
+    }
+    else {
+      m_nodeInfoset[n] = 0;
+    }
+  }
+  m_nodeChildStart[numNodes + 1] = child;
+  m_nodePriorAction[1] = 0;
+
+  m_nodeSubtreeEnd = Array<int>(numNodes);
+  for (int n = numNodes; n >= 1; n--) {
+    m_nodeSubtreeEnd[n] = ((m_nodeChildStart[n] < m_nodeChildStart[n + 1]) ?
+			   m_nodeSubtreeEnd[m_nodeChildren[m_nodeChildStart[n + 1] - 1]] : n);
+  }
+
+  m_flatValid = true;
 }
 
 void GameTreeRep::BuildComputedValues(void)
@@ -746,6 +848,7 @@ void GameTreeRep::BuildComputedValues(void)
   if (m_computedValues) return;
 
   Canonicalize();
+  BuildFlatTree();
 
   for (int pl = 1; pl <= m_players.Length(); pl++) {
     m_players[pl]->MakeReducedStrats(m_root, 0);
@@ -916,6 +1019,181 @@ void GameTreeRep::WriteNfgFile(std::ostream &p_file) const
   p_file << '\n';
 }
 
+//
+// The body of a binary file gives the labels of the players, then the
+// outcomes, then the nodes in the same order as an .efg file.  Each node
+// is written as its type ('c', 'p' or 't') and label; a nonterminal node
+// then gives its player (zero for chance) and the number of its
+// information set, and a flag which is set at the first member of the
+// information set, in which case the label and actions of the information
+// set follow.  Each node ends with the index of its outcome, or zero.
+//
+void GameTreeRep::WriteBinaryFile(std::ostream &p_file) const
+{
+  BinaryFileWriter writer(p_file);
+  writer.WriteHeader(BINARY_TREE, *this);
+
+  writer.WriteInteger(m_players.Length());
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    writer.WriteString(m_players[pl]->m_label);
+  }
+
+  writer.WriteInteger(m_outcomes.Length());
+  for (int outc = 1; outc <= m_outcomes.Length(); outc++) {
+    writer.WriteString(m_outcomes[outc]->m_label);
+    for (int pl = 1; pl <= m_players.Length(); pl++) {
+      writer.WriteNumber(m_outcomes[outc]->m_payoffs[pl]);
+    }
+  }
+
+  // The tree is walked using an explicit stack, so that the depth of
+  // the tree is not limited by the depth of the call stack
+  std::set<GameTreeInfosetRep *> written;
+  std::vector<GameTreeNodeRep *> stack(1, m_root);
+  while (!stack.empty()) {
+    GameTreeNodeRep *node = stack.back();
+    stack.pop_back();
+    GameTreeInfosetRep *infoset = node->infoset;
+
+    if (!infoset) {
+      writer.WriteByte('t');
+      writer.WriteString(node->m_label);
+    }
+    else {
+      bool chance = infoset->m_player->IsChance();
+      writer.WriteByte((chance) ? 'c' : 'p');
+      writer.WriteString(node->m_label);
+      writer.WriteInteger((chance) ? 0 : infoset->m_player->m_number);
+      writer.WriteInteger(infoset->m_number);
+      if (written.insert(infoset).second) {
+	writer.WriteByte(1);
+	writer.WriteString(infoset->m_label);
+	writer.WriteInteger(infoset->m_actions.Length());
+	for (int act = 1; act <= infoset->m_actions.Length(); act++) {
+	  writer.WriteString(infoset->m_actions[act]->m_label);
+	  if (chance) {
+	    writer.WriteNumber(infoset->m_probs[act]);
+	  }
+	}
+      }
+      else {
+	writer.WriteByte(0);
+      }
+    }
+    writer.WriteInteger((node->outcome) ? node->outcome->m_number : 0);
+
+    for (int i = node->children.Length(); i >= 1; i--) {
+      stack.push_back(node->children[i]);
+    }
+  }
+}
+
+Game GameTreeRep::ReadBinaryFile(BinaryFileReader &p_reader)
+{
+  GameTreeRep *efg = new GameTreeRep();
+  Game game = efg;
+
+  int numPlayers = p_reader.ReadCount(4);
+  for (int pl = 1; pl <= numPlayers; pl++) {
+    efg->NewPlayer();
+    efg->m_players[pl]->m_label = p_reader.ReadString();
+  }
+
+  int numOutcomes = p_reader.ReadCount(4);
+  efg->m_outcomes = Array<GameOutcomeRep *>(numOutcomes);
+  for (int outc = 1; outc <= numOutcomes; outc++) {
+    efg->m_outcomes[outc] = new GameOutcomeRep(efg, outc);
+  }
+  for (int outc = 1; outc <= numOutcomes; outc++) {
+    GameOutcomeRep *outcome = efg->m_outcomes[outc];
+    outcome->m_label = p_reader.ReadString();
+    for (int pl = 1; pl <= numPlayers; pl++) {
+      outcome->m_payoffs[pl] = p_reader.ReadNumber();
+    }
+  }
+
+  // Nodes are attached to their information sets directly, rather than
+  // via AppendMove(), so that the tree is canonicalized only once, at
+  // the end, rather than after every move.
+  std::vector<std::map<int, GameTreeInfosetRep *> > infosets(numPlayers + 1);
+  std::vector<GameTreeNodeRep *> stack(1, efg->m_root);
+  // The type byte, label length and outcome index of a node
+  const size_t MinNodeLength = 9;
+  while (!stack.empty()) {
+    GameTreeNodeRep *node = stack.back();
+    stack.pop_back();
+
+    unsigned char type = p_reader.ReadByte();
+    if (type != 't' && type != 'c' && type != 'p') {
+      throw InvalidFileException("Invalid type of node in binary game file");
+    }
+    node->m_label = p_reader.ReadString();
+
+    if (type != 't') {
+      int pl = p_reader.ReadIndex(numPlayers);
+      if ((type == 'c') != (pl == 0)) {
+	throw InvalidFileException("Invalid player in binary game file");
+      }
+      GamePlayerRep *player = (pl) ? efg->m_players[pl] : efg->m_chance;
+      int infosetId = p_reader.ReadInteger();
+      std::map<int, GameTreeInfosetRep *>::iterator entry =
+	infosets[pl].find(infosetId);
+
+      GameTreeInfosetRep *infoset;
+      if (p_reader.ReadByte()) {
+	if (entry != infosets[pl].end()) {
+	  throw InvalidFileException("Information set defined twice in binary game file");
+	}
+	std::string label = p_reader.ReadString();
+	int numActions = p_reader.ReadCount(4);
+	if (numActions == 0) {
+	  throw InvalidFileException("Information set with no actions in binary game file");
+	}
+	infoset = new GameTreeInfosetRep(efg, player->m_infosets.Length() + 1,
+					 player, numActions);
+	infosets[pl][infosetId] = infoset;
+	infoset->m_label = label;
+	for (int act = 1; act <= numActions; act++) {
+	  infoset->m_actions[act]->m_label = p_reader.ReadString();
+	  if (pl == 0) {
+	    infoset->m_probs[act] = p_reader.ReadNumber();
+	  }
+	}
+      }
+      else if (entry != infosets[pl].end()) {
+	infoset = entry->second;
+      }
+      else {
+	throw InvalidFileException("Referencing an undefined infoset in binary game file");
+      }
+
+      // Each node yet to be read occupies at least a type, a label length
+      // and an outcome, so a file too short to describe the children is
+      // rejected before they are created
+      if (stack.size() + infoset->m_actions.Length() >
+	  p_reader.Remaining() / MinNodeLength) {
+	throw InvalidFileException("Binary game file is truncated");
+      }
+      node->infoset = infoset;
+      infoset->AddMember(node);
+      for (int act = 1; act <= infoset->m_actions.Length(); act++) {
+	node->children.Append(new GameTreeNodeRep(efg, node));
+      }
+    }
+
+    int outc = p_reader.ReadIndex(numOutcomes);
+    node->outcome = (outc) ? efg->m_outcomes[outc] : 0;
+
+    for (int i = node->children.Length(); i >= 1; i--) {
+      stack.push_back(node->children[i]);
+    }
+  }
+
+  efg->ClearComputedValues();
+  efg->Canonicalize();
+  return game;
+}
+
 //------------------------------------------------------------------------
 //                 GameTreeRep: Dimensions of the game
 //------------------------------------------------------------------------
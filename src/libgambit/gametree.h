@@ -28,6 +28,7 @@
 namespace Gambit {
 
 class GameTreeRep;
+class BinaryFileReader;
 
 class GameTreeActionRep : public GameActionRep {
   friend class GameTreeRep;
@@ -120,7 +121,7 @@ public:
   virtual Rational GetActionProb(int pl, const Rational &) const
   { return (const Rational &) m_probs[pl]; }
   virtual std::string GetActionProb(int pl, const std::string &) const
-  { return (const std::string &) m_probs[pl]; }
+  { return (std::string) m_probs[pl]; }
 
   virtual void Reveal(GamePlayer);
 };
@@ -200,14 +201,44 @@ class GameTreeRep : public GameExplicitRep {
   friend class GameTreeNodeRep;
   friend class GameTreeInfosetRep;
   friend class GameTreeActionRep;
+  template <class T> friend class MixedBehaviorProfile;
 protected:
   mutable bool m_computedValues;
   GameTreeNodeRep *m_root;
   GamePlayerRep *m_chance;
 
+  /// @name Flattened representation of the tree
+  ///
+  /// Nodes are indexed by number, so parents precede their children.
+  /// Information sets are indexed globally, with those of the personal
+  /// players first (by player, then by number), followed by those of
+  /// chance; actions are indexed globally in the same order.  Zero
+  /// indicates a missing parent, prior action, information set or outcome.
+  //@{
+  /// Are the arrays below consistent with the tree?
+  mutable bool m_flatValid;
+  /// The parent, prior action, information set and outcome of each node
+  Array<int> m_nodeParent, m_nodePriorAction, m_nodeInfoset, m_nodeOutcome;
+  /// The children of node n are m_nodeChildren[m_nodeChildStart[n]]
+  /// up to, but not including, m_nodeChildren[m_nodeChildStart[n+1]]
+  Array<int> m_nodeChildStart, m_nodeChildren;
+  /// The last node in the subtree rooted at each node; since nodes are
+  /// numbered in preorder, the subtree is the range from the node to this
+  Array<int> m_nodeSubtreeEnd;
+  /// The player at each information set (zero for chance), and the
+  /// index of its first action; the entries past the end are sentinels
+  Array<int> m_infosetPlayer, m_infosetFirstAction;
+  /// The members of each information set, laid out as the children are
+  Array<int> m_infosetMemberStart, m_infosetMembers;
+  /// The number of information sets belonging to personal players
+  int m_numPersonalInfosets;
+  //@}
+
   /// @name Private auxiliary functions
   //@{
   void NumberNodes(GameTreeNodeRep *, int &);
+  /// Builds the flattened representation of the tree, if not current
+  void BuildFlatTree(void);
   //@}
 
   /// @name Managing the representation
@@ -224,6 +255,8 @@ public:
   //@{
   GameTreeRep(void);
   virtual ~GameTreeRep();
+  /// Create a game from the body of a file in binary format
+  static Game ReadBinaryFile(BinaryFileReader &);
   virtual Game Copy(void) const;
   //@}
 
@@ -258,6 +291,7 @@ public:
   virtual void WriteEfgFile(std::ostream &) const;
   virtual void WriteEfgFile(std::ostream &, const GameNode &p_node) const;
   virtual void WriteNfgFile(std::ostream &) const;
+  virtual void WriteBinaryFile(std::ostream &) const;
   //@}
 
   /// @name Dimensions of the game
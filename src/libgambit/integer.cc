@@ -43,6 +43,9 @@ Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 #include <cmath>
 #include <cstring>
 #include "libgambit/libgambit.h"
+#ifdef HAVE_LIBGMP
+#include <gmp.h>
+#endif  // HAVE_LIBGMP
 
 namespace Gambit {
 
@@ -176,6 +179,41 @@ static inline void nonnil(const IntegerRep* rep)
   }
 }
 
+// a read-only IntegerRep for an Integer; small values are expanded
+// into a temporary static representation
+
+class IntegerRepView {
+private:
+  union {
+    long m_align;
+    unsigned short m_space[3 + SHORT_PER_LONG];
+  };
+  const IntegerRep *m_rep;
+
+public:
+  IntegerRepView(const Integer &x)
+  {
+    if (x.rep) {
+      m_rep = x.rep;
+      return;
+    }
+    IntegerRep *rep = reinterpret_cast<IntegerRep *>(m_space);
+    unsigned long u = (x.m_value >= 0) ? x.m_value : -x.m_value;
+    int l = 0;
+    while (u != 0) {
+      rep->s[l++] = extract(u);
+      u >>= I_SHIFT;
+    }
+    rep->len = l;
+    rep->sz = 0;
+    rep->sgn = (x.m_value >= 0) ? I_POSITIVE : I_NEGATIVE;
+    m_rep = rep;
+  }
+
+  operator const IntegerRep *(void) const { return m_rep; }
+  const IntegerRep *operator->(void) const { return m_rep; }
+};
+
 // allocate a new Irep. Pad to something close to a power of two.
 
 static IntegerRep* Inew(int newlen)
@@ -322,7 +360,7 @@ IntegerRep* Icopy_ulong(IntegerRep* old, unsigned long x)
   while (x != 0)
   {
     src[srclen++] = extract(x);
-    x = down(x);
+    x >>= I_SHIFT;
   }
 
   IntegerRep* rep;
@@ -372,6 +410,55 @@ IntegerRep* Icopy_one(IntegerRep* old, int newsgn)
   return old;
 }
 
+#ifdef HAVE_LIBGMP
+
+//
+// When configured with GMP, multiplication, division and gcd of
+// multiple-precision values are done by GMP.  The digits of an IntegerRep
+// are exchanged with an mpz_t in both directions by mpz_import/mpz_export.
+//
+
+static void Iset_mpz(mpz_t z, const IntegerRep* x)
+{
+  mpz_import(z, x->len, -1, sizeof(unsigned short), 0, 0, x->s);
+  if (x->sgn == I_NEGATIVE) mpz_neg(z, z);
+}
+
+static IntegerRep* Icopy_mpz(IntegerRep* old, const mpz_t z)
+{
+  int newlen = (int) ((mpz_sizeinbase(z, 2) + I_SHIFT - 1) / I_SHIFT);
+  IntegerRep* rep = Icalloc(old, newlen);
+  size_t count;
+  mpz_export(rep->s, &count, -1, sizeof(unsigned short), 0, 0, z);
+  rep->len = (unsigned short) count;
+  rep->sgn = (mpz_sgn(z) < 0) ? I_NEGATIVE : I_POSITIVE;
+  Icheck(rep);
+  return rep;
+}
+
+// op: '*' product, '/' truncated quotient, '%' remainder, 'g' gcd
+static IntegerRep* Igmp(const IntegerRep* x, const IntegerRep* y,
+                        IntegerRep* r, char op)
+{
+  mpz_t a, b;
+  mpz_init(a);
+  mpz_init(b);
+  Iset_mpz(a, x);
+  Iset_mpz(b, y);
+  switch (op) {
+  case '*':  mpz_mul(a, a, b);  break;
+  case '/':  mpz_tdiv_q(a, a, b);  break;
+  case '%':  mpz_tdiv_r(a, a, b);  break;
+  default:  mpz_gcd(a, a, b);  break;
+  }
+  r = Icopy_mpz(r, a);
+  mpz_clear(a);
+  mpz_clear(b);
+  return r;
+}
+
+#endif  // HAVE_LIBGMP
+
 // convert to a legal two's complement long if possible
 // if too big, return most negative/positive value
 
@@ -502,7 +589,8 @@ double ratio(const Integer& num, const Integer& den)
     double  d2 = 0.0;
     double  d3 = 0.0; 
     int cont = 1;
-    for (int i = den.rep->len - 1; i >= 0 && cont; --i)
+    IntegerRepView dr(den), rr(r);
+    for (int i = dr->len - 1; i >= 0 && cont; --i)
     {
 		unsigned short a = (unsigned short) (I_RADIX >> 1);
       while (a != 0)
@@ -514,13 +602,13 @@ double ratio(const Integer& num, const Integer& den)
         }
 
         d2 *= 2.0;
-        if (den.rep->s[i] & a)
+        if (dr->s[i] & a)
           d2 += 1.0;
 
-        if (i < r.rep->len)
+        if (i < rr->len)
         {
           d3 *= 2.0;
-          if (r.rep->s[i] & a)
+          if (rr->s[i] & a)
             d3 += 1.0;
         }
 
@@ -866,6 +954,9 @@ IntegerRep* multiply(const IntegerRep* x, const IntegerRep* y, IntegerRep* r)
 {
   nonnil(x);
   nonnil(y);
+#ifdef HAVE_LIBGMP
+  return Igmp(x, y, r, '*');
+#else
   int xl = x->len;
   int yl = y->len;
   int rl = xl + yl;
@@ -1011,6 +1102,7 @@ IntegerRep* multiply(const IntegerRep* x, const IntegerRep* y, IntegerRep* r)
   r->sgn = rsgn;
   Icheck(r);
   return r;
+#endif  // HAVE_LIBGMP
 }
 
 
@@ -1226,12 +1318,14 @@ IntegerRep* div(const IntegerRep* x, const IntegerRep* y, IntegerRep* q)
 {
   nonnil(x);
   nonnil(y);
-  int xl = x->len;
   int yl = y->len;
   if (yl == 0) {
     throw Gambit::ZeroDivideException();
   }
-
+#ifdef HAVE_LIBGMP
+  return Igmp(x, y, q, '/');
+#else
+  int xl = x->len;
   int comp = ucompare(x, y);
   int xsgn = x->sgn;
   int ysgn = y->sgn;
@@ -1275,6 +1369,7 @@ IntegerRep* div(const IntegerRep* x, const IntegerRep* y, IntegerRep* q)
   q->sgn = samesign;
   Icheck(q);
   return q;
+#endif  // HAVE_LIBGMP
 }
 
 IntegerRep* div(const IntegerRep* x, long y, IntegerRep* q)
@@ -1296,7 +1391,7 @@ IntegerRep* div(const IntegerRep* x, long y, IntegerRep* q)
   while (u != 0)
   {
     ys[yl++] = extract(u);
-    u = down(u);
+    u >>= I_SHIFT;
   }
 
   int comp = xl - yl;
@@ -1349,103 +1444,59 @@ IntegerRep* div(const IntegerRep* x, long y, IntegerRep* q)
 
 void divide(const Integer& Ix, long y, Integer& Iq, long& rem)
 {
-  const IntegerRep* x = Ix.rep;
-  nonnil(x);
-  IntegerRep* q = Iq.rep;
-  int xl = x->len;
-  if (y == 0) {
-    throw Gambit::ZeroDivideException();
-  }
-  unsigned short ys[SHORT_PER_LONG];
-  unsigned long u;
-  int ysgn = y >= 0;
-  if (ysgn)
-    u = y;
-  else
-    u = -y;
-  int yl = 0;
-  while (u != 0)
+  if (!Ix.rep && y != 0 && y != LONG_MIN)
   {
-    ys[yl++] = extract(u);
-    u = down(u);
+    long x = Ix.m_value;
+    rem = x % y;
+    Iq.SetSmall(x / y);
+    return;
   }
-
-  int comp = xl - yl;
-  if (comp == 0) comp = docmp(x->s, ys, xl);
-
-  int xsgn = x->sgn;
-  int samesign = xsgn == ysgn;
-
-  if (comp < 0)
-  {
-    rem = Itolong(x);
-    q = Icopy_zero(q);
-  }
-  else if (comp == 0)
-  {
-    q = Icopy_one(q, samesign);
-    rem = 0;
-  }
-  else if (yl == 1)
-  {
-    q = Icopy(q, x);
-    rem = unscale(q->s, q->len, ys[0], q->s);
-  }
-  else
-  {
-    IntegerRep* r  = 0;
-	 unsigned short prescale = (unsigned short) (I_RADIX / (1 + ys[yl - 1]));
-    if (prescale != 1)
-    {
-      unsigned long prod = (unsigned long)prescale * (unsigned long)ys[0];
-      ys[0] = extract(prod);
-      prod = down(prod) + (unsigned long)prescale * (unsigned long)ys[1];
-      ys[1] = extract(prod);
-      r = multiply(x, ((long)prescale & I_MAXNUM), r);
-    }
-    else
-    {
-      r = Icalloc(r, xl + 1);
-      scpy(x->s, r->s, xl);
-    }
-
-    int ql = xl - yl + 1;
-      
-    q = Icalloc(q, ql);
-    
-    do_divide(r->s, ys, yl, q->s, ql);
-
-    if (prescale != 1)
-    {
-      Icheck(r);
-      unscale(r->s, r->len, prescale, r->s);
-    }
-    Icheck(r);
-    rem = Itolong(r);
-    if (!STATIC_IntegerRep(r)) delete r;
-  }
-  rem = abs(rem).as_long();
-  if (xsgn == I_NEGATIVE) rem = -rem;
-  q->sgn = samesign;
-  Icheck(q);
-  Iq.rep = q;
+  Integer r;
+  divide(Ix, Integer(y), Iq, r);
+  rem = r.as_long();
 }
 
 
 void divide(const Integer& Ix, const Integer& Iy, Integer& Iq, Integer& Ir)
 {
-  const IntegerRep* x = Ix.rep;
+  if (!Ix.rep && !Iy.rep && Iy.m_value != 0)
+  {
+    long x = Ix.m_value, y = Iy.m_value;
+    Iq.SetSmall(x / y);
+    Ir.SetSmall(x % y);
+    return;
+  }
+  IntegerRepView xv(Ix), yv(Iy);
+  const IntegerRep* x = xv;
   nonnil(x);
-  const IntegerRep* y = Iy.rep;
+  const IntegerRep* y = yv;
   nonnil(y);
   IntegerRep* q = Iq.rep;
   IntegerRep* r = Ir.rep;
 
-  int xl = x->len;
   int yl = y->len;
   if (yl == 0) {
     throw Gambit::ZeroDivideException();
   }
+#ifdef HAVE_LIBGMP
+  mpz_t zx, zy, zq, zr;
+  mpz_init(zx);
+  mpz_init(zy);
+  mpz_init(zq);
+  mpz_init(zr);
+  Iset_mpz(zx, x);
+  Iset_mpz(zy, y);
+  mpz_tdiv_qr(zq, zr, zx, zy);
+  Iq.rep = Icopy_mpz(q, zq);
+  Ir.rep = Icopy_mpz(r, zr);
+  mpz_clear(zx);
+  mpz_clear(zy);
+  mpz_clear(zq);
+  mpz_clear(zr);
+  Iq.Normalize();
+  Ir.Normalize();
+#else
+  int xl = x->len;
   int comp = ucompare(x, y);
   int xsgn = x->sgn;
   int ysgn = y->sgn;
@@ -1484,6 +1535,7 @@ void divide(const Integer& Ix, const Integer& Iy, Integer& Iq, Integer& Ir)
       yy = (IntegerRep*)y;
       r = Icalloc(r, xl + 1);
       scpy(x->s, r->s, xl);
+      r->sgn = xsgn;
     }
 
     int ql = xl - yl + 1;
@@ -1503,19 +1555,24 @@ void divide(const Integer& Ix, const Integer& Iy, Integer& Iq, Integer& Ir)
   Iq.rep = q;
   Icheck(r);
   Ir.rep = r;
+  Iq.Normalize();
+  Ir.Normalize();
+#endif  // HAVE_LIBGMP
 }
 
 IntegerRep* mod(const IntegerRep* x, const IntegerRep* y, IntegerRep* r)
 {
   nonnil(x);
   nonnil(y);
-  int xl = x->len;
   int yl = y->len;
   // if (yl == 0) (*lib_error_handler)("Integer", "attempted division by zero");
   if (yl == 0) {
     throw Gambit::ZeroDivideException();
   }
-
+#ifdef HAVE_LIBGMP
+  return Igmp(x, y, r, '%');
+#else
+  int xl = x->len;
   int comp = ucompare(x, y);
   int xsgn = x->sgn;
 
@@ -1544,6 +1601,7 @@ IntegerRep* mod(const IntegerRep* x, const IntegerRep* y, IntegerRep* r)
       yy = (IntegerRep*)y;
       r = Icalloc(r, xl + 1);
       scpy(x->s, r->s, xl);
+      r->sgn = xsgn;
     }
       
     do_divide(r->s, yy->s, yl, 0, xl - yl + 1);
@@ -1558,6 +1616,7 @@ IntegerRep* mod(const IntegerRep* x, const IntegerRep* y, IntegerRep* r)
   }
   Icheck(r);
   return r;
+#endif  // HAVE_LIBGMP
 }
 
 IntegerRep* mod(const IntegerRep* x, long y, IntegerRep* r)
@@ -1578,7 +1637,7 @@ IntegerRep* mod(const IntegerRep* x, long y, IntegerRep* r)
   while (u != 0)
   {
     ys[yl++] = extract(u);
-    u = down(u);
+    u >>= I_SHIFT;
   }
 
   int comp = xl - yl;
@@ -1775,7 +1834,7 @@ IntegerRep* bitop(const IntegerRep* x, long y, IntegerRep* r, char op)
   while (u != 0)
   {
 	 tmp[l++] = extract(u);
-	 u = down(u);
+	 u >>= I_SHIFT;
   }
 
   int xl = x->len;
@@ -1856,11 +1915,13 @@ void (setbit)(Integer& x, long b)
   {
 	 int bw = (int) ((unsigned long)b / I_SHIFT);
 	 int sw = (int) ((unsigned long)b % I_SHIFT);
-    int xl = x.rep ? x.rep->len : 0;
+    x.Promote();
+    int xl = x.rep->len;
     if (xl <= bw)
       x.rep = Iresize(x.rep, calc_len(xl, bw+1, 0));
     x.rep->s[bw] |= (1 << sw);
     Icheck(x.rep);
+    x.Normalize();
   }
 }
 
@@ -1868,26 +1929,26 @@ void clearbit(Integer& x, long b)
 {
   if (b >= 0)
     {
-      if (x.rep == 0)
-	x.rep = &_ZeroRep;
-      else
-	{
-	  int bw = (int) ((unsigned long)b / I_SHIFT);
-	  int sw = (int) ((unsigned long)b % I_SHIFT);
-	  if (x.rep->len > bw)
-	    x.rep->s[bw] &= ~(1 << sw);
-	}
+      x.Promote();
+      if (STATIC_IntegerRep(x.rep))
+	x.rep = Icopy(0, x.rep);
+      int bw = (int) ((unsigned long)b / I_SHIFT);
+      int sw = (int) ((unsigned long)b % I_SHIFT);
+      if (x.rep->len > bw)
+	x.rep->s[bw] &= ~(1 << sw);
     Icheck(x.rep);
+    x.Normalize();
   }
 }
 
 int testbit(const Integer& x, long b)
 {
-  if (x.rep != 0 && b >= 0)
+  if (b >= 0)
   {
+    IntegerRepView xv(x);
 	 int bw = (int) ((unsigned long)b / I_SHIFT);
 	 int sw = (int) ((unsigned long)b % I_SHIFT);
-    return (bw < x.rep->len && (x.rep->s[bw] & (1 << sw)) != 0);
+    return (bw < xv->len && (xv->s[bw] & (1 << sw)) != 0);
   }
   else
     return 0;
@@ -1900,6 +1961,9 @@ IntegerRep* gcd(const IntegerRep* x, const IntegerRep* y)
 {
   nonnil(x);
   nonnil(y);
+#ifdef HAVE_LIBGMP
+  return Igmp(x, y, 0, 'g');
+#else
   int ul = x->len;
   int vl = y->len;
   
@@ -1988,6 +2052,7 @@ IntegerRep* gcd(const IntegerRep* x, const IntegerRep* y)
   if (!STATIC_IntegerRep(v)) delete v;
   if (k != 0) u = lshift(u, k, u);
   return u;
+#endif  // HAVE_LIBGMP
 }
 
 
@@ -2196,7 +2261,7 @@ std::string Itoa(const IntegerRep *x, int base, int width)
 
 std::ostream &operator<<(std::ostream &s, const Integer &y)
 {
-  return s << Itoa(y.rep);
+  return s << Itoa(IntegerRepView(y));
 }
 
 std::string cvtItoa(const IntegerRep *x, std::string fmt, int& fmtlen, int base, int showbase,
@@ -2295,7 +2360,7 @@ std::istream &operator>>(std::istream &s, Integer& y)
 {
   char sgn = 0;
   char ch;
-  y.rep = Icopy_zero(y.rep);
+  y = 0L;
 
   do  {
 	 s.get(ch);
@@ -2334,7 +2399,9 @@ std::istream &operator>>(std::istream &s, Integer& y)
 
 int Integer::OK() const
 {
-  if (rep != 0)
+  if (rep == 0)
+    return m_value != LONG_MIN;
+  else
 	 {
       int l = rep->len;
       int s = rep->sgn;
@@ -2361,240 +2428,436 @@ void Integer::error(const char* msg) const
 // The following were moved from the header file to stop BC from squealing
 // endless quantities of warnings
 
-Integer::Integer() :rep(&_ZeroRep) {}
+Integer::Integer() : m_value(0), rep(0) {}
 
-Integer::Integer(IntegerRep* r) :rep(r) {}
+Integer::Integer(IntegerRep* r) : m_value(0), rep(r) { Normalize(); }
 
-Integer::Integer(int y) :rep(Icopy_long(0, (long)y)) {}
+Integer::Integer(int y) : m_value(y), rep(0) {}
 
-Integer::Integer(long y) :rep(Icopy_long(0, y)) {}
+Integer::Integer(long y) : m_value(y), rep(0)
+{
+  if (y == LONG_MIN) rep = Icopy_long(0, y);
+}
 
-Integer::Integer(unsigned long y) :rep(Icopy_ulong(0, y)) {}
+Integer::Integer(unsigned long y) : m_value((long) y), rep(0)
+{
+  if (y > (unsigned long) LONG_MAX) rep = Icopy_ulong(0, y);
+}
 
-Integer::Integer(const Integer&  y) :rep(Icopy(0, y.rep)) {}
+Integer::Integer(const Integer&  y)
+  : m_value(y.m_value), rep((y.rep) ? Icopy(0, y.rep) : 0) {}
 
 Integer::~Integer() { if (rep && !STATIC_IntegerRep(rep)) delete[] rep; }
 
 Integer &Integer::operator=(const Integer &y)
 {
-  rep = Icopy(rep, y.rep);
+  if (y.rep)
+    rep = Icopy(rep, y.rep);
+  else
+    SetSmall(y.m_value);
   return *this;
 }
 
 Integer &Integer::operator=(long y)
 {
-  rep = Icopy_long(rep, y); 
+  if (y != LONG_MIN)
+    SetSmall(y);
+  else
+    rep = Icopy_long(rep, y);
   return *this;
 }
 
+void Integer::SetSmall(long y)
+{
+  if (rep)
+  {
+    if (!STATIC_IntegerRep(rep)) delete[] rep;
+    rep = 0;
+  }
+  m_value = y;
+}
+
+void Integer::Normalize(void)
+{
+  if (rep && Iislong(rep))
+  {
+    long y = Itolong(rep);
+    if (y != LONG_MIN) SetSmall(y);
+  }
+}
+
+void Integer::Promote(void)
+{
+  if (!rep) rep = Icopy_long(0, m_value);
+}
+
 int Integer::initialized() const
 {
-  return rep != 0;
+  return 1;
+}
+
+double Integer::as_double() const
+{
+  // Values with more bits than the mantissa are converted through the
+  // multiple-precision code, which rounds differently than the hardware
+  const long exact = 1L << (DBL_MANT_DIG < 62 ? DBL_MANT_DIG : 62);
+  if (!rep && m_value < exact && m_value > -exact)
+    return (double) m_value;
+  return Itodouble(IntegerRepView(*this));
+}
+
+//
+// Overflow-checked arithmetic on small values.  Each returns false if
+// the result is not representable as a small value.
+//
+
+static inline bool small_add(long x, long y, long &r)
+{
+#if defined(__GNUC__) && __GNUC__ >= 5
+  return !__builtin_add_overflow(x, y, &r) && r != LONG_MIN;
+#else
+  if ((y > 0 && x > LONG_MAX - y) || (y < 0 && x < -LONG_MAX - y))
+    return false;
+  r = x + y;
+  return true;
+#endif  // __GNUC__
+}
+
+static inline bool small_mul(long x, long y, long &r)
+{
+#if defined(__GNUC__) && __GNUC__ >= 5
+  return !__builtin_mul_overflow(x, y, &r) && r != LONG_MIN;
+#else
+  if (x != 0 && y != 0)
+  {
+    unsigned long ux = (x >= 0) ? x : -x;
+    unsigned long uy = (y >= 0) ? y : -y;
+    if (ux > (unsigned long) LONG_MAX / uy)
+      return false;
+  }
+  r = x * y;
+  return true;
+#endif  // __GNUC__
+}
+
+static inline int small_compare(long x, long y)
+{
+  return (x < y) ? -1 : ((x > y) ? 1 : 0);
+}
+
+static inline int small_ucompare(long x, long y)
+{
+  unsigned long ux = (x >= 0) ? (unsigned long) x : 0UL - (unsigned long) x;
+  unsigned long uy = (y >= 0) ? (unsigned long) y : 0UL - (unsigned long) y;
+  return (ux < uy) ? -1 : ((ux > uy) ? 1 : 0);
+}
+
+static inline long small_gcd(long x, long y)
+{
+  unsigned long u = (x >= 0) ? x : -x;
+  unsigned long v = (y >= 0) ? y : -y;
+  while (v != 0)
+  {
+    unsigned long t = u % v;
+    u = v;
+    v = t;
+  }
+  return (long) u;
 }
 
 // procedural versions
 
 int compare(const Integer& x, const Integer& y)
 {
-  return compare(x.rep, y.rep);
+  if (!x.rep && !y.rep) return small_compare(x.m_value, y.m_value);
+  return compare(IntegerRepView(x), IntegerRepView(y));
 }
 
 int ucompare(const Integer& x, const Integer& y)
 {
-  return ucompare(x.rep, y.rep);
+  if (!x.rep && !y.rep) return small_ucompare(x.m_value, y.m_value);
+  return ucompare(IntegerRepView(x), IntegerRepView(y));
 }
 
 int compare(const Integer& x, long y)
 {
-  return compare(x.rep, y);
+  if (!x.rep) return small_compare(x.m_value, y);
+  return compare(x, Integer(y));
 }
 
 int ucompare(const Integer& x, long y)
 {
-  return ucompare(x.rep, y);
+  if (!x.rep) return small_ucompare(x.m_value, y);
+  return ucompare(x, Integer(y));
 }
 
 int compare(long x, const Integer& y)
 {
-  return -compare(y.rep, x);
+  return -compare(y, x);
 }
 
 int ucompare(long x, const Integer& y)
 {
-  return -ucompare(y.rep, x);
+  return -ucompare(y, x);
 }
 
 void  add(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = add(x.rep, 0, y.rep, 0, dest.rep);
+  long r;
+  if (!x.rep && !y.rep && small_add(x.m_value, y.m_value, r))
+  {
+    dest.SetSmall(r);
+    return;
+  }
+  dest.rep = add(IntegerRepView(x), 0, IntegerRepView(y), 0, dest.rep);
+  dest.Normalize();
 }
 
 void  sub(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = add(x.rep, 0, y.rep, 1, dest.rep);
+  long r;
+  if (!x.rep && !y.rep && small_add(x.m_value, -y.m_value, r))
+  {
+    dest.SetSmall(r);
+    return;
+  }
+  dest.rep = add(IntegerRepView(x), 0, IntegerRepView(y), 1, dest.rep);
+  dest.Normalize();
 }
 
 void  mul(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = multiply(x.rep, y.rep, dest.rep);
+  long r;
+  if (!x.rep && !y.rep && small_mul(x.m_value, y.m_value, r))
+  {
+    dest.SetSmall(r);
+    return;
+  }
+  dest.rep = multiply(IntegerRepView(x), IntegerRepView(y), dest.rep);
+  dest.Normalize();
 }
 
 void  div(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = div(x.rep, y.rep, dest.rep);
+  if (!x.rep && !y.rep && y.m_value != 0)
+  {
+    dest.SetSmall(x.m_value / y.m_value);
+    return;
+  }
+  dest.rep = div(IntegerRepView(x), IntegerRepView(y), dest.rep);
+  dest.Normalize();
 }
 
 void  mod(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = mod(x.rep, y.rep, dest.rep);
+  if (!x.rep && !y.rep && y.m_value != 0)
+  {
+    dest.SetSmall(x.m_value % y.m_value);
+    return;
+  }
+  dest.rep = mod(IntegerRepView(x), IntegerRepView(y), dest.rep);
+  dest.Normalize();
 }
 
 void  lshift(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = lshift(x.rep, y.rep, 0, dest.rep);
+  dest.rep = lshift(IntegerRepView(x), IntegerRepView(y), 0, dest.rep);
+  dest.Normalize();
 }
 
 void  rshift(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = lshift(x.rep, y.rep, 1, dest.rep);
+  dest.rep = lshift(IntegerRepView(x), IntegerRepView(y), 1, dest.rep);
+  dest.Normalize();
 }
 
 void  pow(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = power(x.rep, Itolong(y.rep), dest.rep); // not incorrect
+  dest.rep = power(IntegerRepView(x), y.as_long(), dest.rep); // not incorrect
+  dest.Normalize();
 }
 
 void  add(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = add(x.rep, 0, y, dest.rep);
+  long r;
+  if (!x.rep && y != LONG_MIN && small_add(x.m_value, y, r))
+  {
+    dest.SetSmall(r);
+    return;
+  }
+  add(x, Integer(y), dest);
 }
 
 void  sub(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = add(x.rep, 0, -y, dest.rep);
+  long r;
+  if (!x.rep && y != LONG_MIN && small_add(x.m_value, -y, r))
+  {
+    dest.SetSmall(r);
+    return;
+  }
+  sub(x, Integer(y), dest);
 }
 
 void  mul(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = multiply(x.rep, y, dest.rep);
+  long r;
+  if (!x.rep && y != LONG_MIN && small_mul(x.m_value, y, r))
+  {
+    dest.SetSmall(r);
+    return;
+  }
+  mul(x, Integer(y), dest);
 }
 
 void  div(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = div(x.rep, y, dest.rep);
+  if (!x.rep && y != 0 && y != LONG_MIN)
+  {
+    dest.SetSmall(x.m_value / y);
+    return;
+  }
+  div(x, Integer(y), dest);
 }
 
 void  mod(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = mod(x.rep, y, dest.rep);
+  if (!x.rep && y != 0 && y != LONG_MIN)
+  {
+    dest.SetSmall(x.m_value % y);
+    return;
+  }
+  mod(x, Integer(y), dest);
 }
 
 
 void  lshift(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = lshift(x.rep, y, dest.rep);
+  dest.rep = lshift(IntegerRepView(x), y, dest.rep);
+  dest.Normalize();
 }
 
 void  rshift(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = lshift(x.rep, -y, dest.rep);
+  dest.rep = lshift(IntegerRepView(x), -y, dest.rep);
+  dest.Normalize();
 }
 
 void  pow(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = power(x.rep, y, dest.rep);
+  dest.rep = power(IntegerRepView(x), y, dest.rep);
+  dest.Normalize();
 }
 
 void abs(const Integer& x, Integer& dest)
 {
+  if (!x.rep)
+  {
+    dest.SetSmall((x.m_value >= 0) ? x.m_value : -x.m_value);
+    return;
+  }
   dest.rep = abs(x.rep, dest.rep);
+  dest.Normalize();
 }
 
 void negate(const Integer& x, Integer& dest)
 {
+  if (!x.rep)
+  {
+    dest.SetSmall(-x.m_value);
+    return;
+  }
   dest.rep = negate(x.rep, dest.rep);
+  dest.Normalize();
 }
 
 void complement(const Integer& x, Integer& dest)
 {
-  dest.rep = Compl(x.rep, dest.rep);
+  dest.rep = Compl(IntegerRepView(x), dest.rep);
+  dest.Normalize();
 }
 
 void  add(long x, const Integer& y, Integer& dest)
 {
-  dest.rep = add(y.rep, 0, x, dest.rep);
+  add(y, x, dest);
 }
 
 void  sub(long x, const Integer& y, Integer& dest)
 {
-  dest.rep = add(y.rep, 1, x, dest.rep);
+  long r;
+  if (!y.rep && small_add(x, -y.m_value, r))
+  {
+    dest.SetSmall(r);
+    return;
+  }
+  sub(Integer(x), y, dest);
 }
 
 void  mul(long x, const Integer& y, Integer& dest)
 {
-  dest.rep = multiply(y.rep, x, dest.rep);
+  mul(y, x, dest);
 }
 
 // operator versions
 
 bool Integer::operator==(const Integer &y) const
 {
-  return compare(*this, y) == 0; 
+  return compare(*this, y) == 0;
 }
 
 bool Integer::operator==(long y) const
 {
-  return compare(*this, y) == 0; 
+  return compare(*this, y) == 0;
 }
 
 bool Integer::operator!=(const Integer &y) const
 {
-  return compare(*this, y) != 0; 
+  return compare(*this, y) != 0;
 }
 
 bool Integer::operator!=(long y) const
 {
-  return compare(*this, y) != 0; 
+  return compare(*this, y) != 0;
 }
 
 bool Integer::operator<(const Integer &y) const
 {
-  return compare(*this, y) <  0; 
+  return compare(*this, y) <  0;
 }
 
 bool Integer::operator<(long y) const
 {
-  return compare(*this, y) <  0; 
+  return compare(*this, y) <  0;
 }
 
 bool Integer::operator<=(const Integer &y) const
 {
-  return compare(*this, y) <= 0; 
+  return compare(*this, y) <= 0;
 }
 
 bool Integer::operator<=(long y) const
 {
-  return compare(*this, y) <= 0; 
+  return compare(*this, y) <= 0;
 }
 
 bool Integer::operator>(const Integer &y) const
 {
-  return compare(*this, y) >  0; 
+  return compare(*this, y) >  0;
 }
 
 bool Integer::operator>(long y) const
 {
-  return compare(*this, y) >  0; 
+  return compare(*this, y) >  0;
 }
 
 bool Integer::operator>=(const Integer &y) const
 {
-  return compare(*this, y) >= 0; 
+  return compare(*this, y) >= 0;
 }
 
 bool Integer::operator>=(long y) const
 {
-  return compare(*this, y) >= 0; 
+  return compare(*this, y) >= 0;
 }
 
 
@@ -2698,32 +2961,35 @@ void Integer::negate()
 
 int sign(const Integer& x)
 {
+  if (!x.rep) return (x.m_value > 0) - (x.m_value < 0);
   return (x.rep->len == 0) ? 0 : ( (x.rep->sgn == 1) ? 1 : -1 );
 }
 
 int even(const Integer& y)
 {
+  if (!y.rep) return !(y.m_value & 1);
   return y.rep->len == 0 || !(y.rep->s[0] & 1);
 }
 
 int odd(const Integer& y)
 {
+  if (!y.rep) return (y.m_value & 1) != 0;
   return y.rep->len > 0 && (y.rep->s[0] & 1);
 }
 
 std::string Itoa(const Integer& y, int base, int width)
 {
-  return Itoa(y.rep, base, width);
+  return Itoa(IntegerRepView(y), base, width);
 }
 
 
 
-long lg(const Integer& x) 
+long lg(const Integer& x)
 {
-  return lg(x.rep);
+  return lg(IntegerRepView(x));
 }
 
-// constructive operations 
+// constructive operations
 
 Integer Integer::operator+(const Integer &y) const
 {
@@ -2767,7 +3033,7 @@ Integer Integer::operator*(long y) const
   return r;
 }
 
-Integer sqr(const Integer& x) 
+Integer sqr(const Integer& x)
 {
   Integer r;
   mul(x, x, r);
@@ -2788,7 +3054,7 @@ Integer Integer::operator/(long y) const
   return r;
 }
 
-Integer Integer::operator%(const Integer &y) const 
+Integer Integer::operator%(const Integer &y) const
 {
   Integer r;
   mod(*this, y, r);
@@ -2816,7 +3082,7 @@ Integer Integer::operator<<(long y) const
   return r;
 }
 
-Integer Integer::operator>>(const Integer &y) const 
+Integer Integer::operator>>(const Integer &y) const
 {
   Integer r;
   rshift(*this, y, r);
@@ -2844,7 +3110,7 @@ Integer Ipow(long x, long y)
   return r;
 }
 
-Integer pow(const Integer& x, const Integer& y) 
+Integer pow(const Integer& x, const Integer& y)
 {
   Integer r;
   pow(x, y, r);
@@ -2853,7 +3119,7 @@ Integer pow(const Integer& x, const Integer& y)
 
 
 
-Integer abs(const Integer& x) 
+Integer abs(const Integer& x)
 {
   Integer r;
   abs(x, r);
@@ -2868,17 +3134,24 @@ Integer Integer::operator-(void) const
 }
 
 
-Integer  atoI(const char* s, int base) 
+Integer  atoI(const char* s, int base)
 {
   Integer r;
   r.rep = atoIntegerRep(s, base);
+  r.Normalize();
   return r;
 }
 
 Integer  gcd(const Integer& x, const Integer& y)
 {
   Integer r;
-  r.rep = gcd(x.rep, y.rep);
+  if (!x.rep && !y.rep)
+  {
+    r.m_value = small_gcd(x.m_value, y.m_value);
+    return r;
+  }
+  r.rep = gcd(IntegerRepView(x), IntegerRepView(y));
+  r.Normalize();
   return r;
 }
 
@@ -82,10 +82,28 @@ extern int      Iislong(const IntegerRep*);
 extern int      Iisdouble(const IntegerRep*);
 extern long     lg(const IntegerRep*);
 
+class IntegerRepView;
+
+/// \brief An arbitrary-precision integer
+///
+/// Values which fit in a long (other than LONG_MIN) are stored directly,
+/// and arithmetic on them is done in machine words.  The multiple-precision
+/// representation is used only for values which do not fit.
 class Integer {
+  friend class IntegerRepView;
 protected:
+  /// The value, if rep is null
+  long m_value;
+  /// The multiple-precision representation, or null if the value is small
   IntegerRep *rep;
 
+  /// Sets the value to a small value
+  void SetSmall(long);
+  /// Converts to the small representation, if the value fits
+  void Normalize(void);
+  /// Converts to the multiple-precision representation
+  void Promote(void);
+
 public:
   /// @name Lifecycle
   //@{
@@ -218,11 +236,11 @@ public:
 
   // coercion & conversion
 
-  int             fits_in_long() const { return Iislong(rep); }
-  int             fits_in_double() const { return Iisdouble(rep); }
+  int             fits_in_long() const { return (rep) ? Iislong(rep) : 1; }
+  int             fits_in_double() const { return (rep) ? Iisdouble(rep) : 1; }
 
-  long		  as_long() const { return Itolong(rep); }
-  double	  as_double() const { return Itodouble(rep); }
+  long		  as_long() const { return (rep) ? Itolong(rep) : m_value; }
+  double	  as_double() const;
 
   friend std::string Itoa(const Integer &x, int base /*= 10*/, int width /*= 0*/);
   friend Integer atoI(const char *s, int base/*= 10*/);
@@ -24,6 +24,7 @@
 #define LIBGAMBIT_MIXED_H
 
 #include "vector.h"
+#include "matrix.h"
 #include "gameagg.h"
 #include "gamebagg.h"
 
@@ -52,6 +53,10 @@ public:
   virtual T GetPayoff(int pl) const = 0;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &) const = 0;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &, const GameStrategy &) const = 0;
+  virtual void GetPayoffs(Vector<T> &p_payoffs, Vector<T> &p_values) const;
+  virtual void GetPayoffDerivs(Vector<T> &p_values, Matrix<T> &p_derivs) const;
+  virtual void SetPlayerStrategy(int pl, const Vector<T> &p_probs,
+				 Vector<T> &p_payoffs);
 };
 
 template <class T> class TreeMixedStrategyProfileRep 
@@ -72,21 +77,58 @@ public:
 template <class T> class TableMixedStrategyProfileRep
   : public MixedStrategyProfileRep<T> {
 private:
+  /// @name Private tensor contraction functions
+  //@{
+  /// Lays out each player's strategy probabilities along that player's
+  /// axis of the payoff table, with zeros for strategies not in the support
+  void GetWeights(const GameTableRep &, 
+		  std::vector<std::vector<T> > &p_weights) const;
+  /// Contracts the payoff table along every player's axis except p_keep;
+  /// if p_first is nonzero, that player's axis, whose weights may have
+  /// few nonzero entries, is contracted first
+  void Contract(const GameTableRep &, const T *p_payoffs,
+		const std::vector<std::vector<T> > &p_weights, int p_keep,
+		std::vector<T> &p_result, int p_first = 0) const;
+  //@}
+
   /// @name Private recursive payoff functions
   //@{
-  /// Recursive computation of payoff to player pl
-  T GetPayoff(int pl, int index, int i) const;
   /// Recursive computation of payoff derivative
-  void GetPayoffDeriv(int pl, int const_pl, int cur_pl, long index,
-		      const T &prob, T &value) const;
+  void GetPayoffDeriv(const T *p_payoffs, int const_pl, int cur_pl, 
+		      long index, const T &prob, T &value) const;
   /// Recursive computation of payoff second derivative
-  void GetPayoffDeriv(int pl, int const_pl1, int const_pl2, 
+  void GetPayoffDeriv(const T *p_payoffs, int const_pl1, int const_pl2, 
 		      int cur_pl, long index, const T &prob, T &value) const;
   //@}
 
+  /// @name Cached contractions for SetPlayerStrategy()
+  /// Each array is indexed by the player whose axis is kept
+  //@{
+  /// Whether the contractions have been computed
+  std::vector<bool> m_cacheValid;
+  /// The version of the game's payoffs the contractions were computed from
+  std::vector<long> m_cacheVersion;
+  /// The number of changes made to the contractions since computed
+  std::vector<int> m_cacheUpdates;
+  /// The probabilities from which the contractions were computed
+  std::vector<Vector<T> > m_cacheProbs;
+  /// Each player's payoff table, contracted along all axes but the kept one
+  std::vector<std::vector<std::vector<T> > > m_cacheSlices;
+  //@}
+
+  /// Returns true if the contractions keeping the player's axis are
+  /// valid for the current payoffs and other players' probabilities
+  bool IsCacheValid(const GameTableRep &, int pl);
+
 public:
   TableMixedStrategyProfileRep(const StrategySupportProfile &p_support)
-    : MixedStrategyProfileRep<T>(p_support)
+    : MixedStrategyProfileRep<T>(p_support),
+      m_cacheValid(p_support.NumPlayers(), false),
+      m_cacheVersion(p_support.NumPlayers(), 0L),
+      m_cacheUpdates(p_support.NumPlayers(), 0),
+      m_cacheProbs(p_support.NumPlayers(),
+		   Vector<T>(p_support.MixedProfileLength())),
+      m_cacheSlices(p_support.NumPlayers())
   { }
   virtual ~TableMixedStrategyProfileRep() { }
 
@@ -94,6 +136,10 @@ public:
   virtual T GetPayoff(int pl) const;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &) const;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &, const GameStrategy &) const;
+  virtual void GetPayoffs(Vector<T> &p_payoffs, Vector<T> &p_values) const;
+  virtual void GetPayoffDerivs(Vector<T> &p_values, Matrix<T> &p_derivs) const;
+  virtual void SetPlayerStrategy(int pl, const Vector<T> &p_probs,
+				 Vector<T> &p_payoffs);
 };
 
 template <class T> class AggMixedStrategyProfileRep
@@ -253,6 +299,43 @@ public:
   T GetPayoff(const GameStrategy &p_strategy) const
   { return GetPayoffDeriv(p_strategy->GetPlayer()->GetNumber(), p_strategy); }
 
+  /// \brief Computes the payoffs to all players and all strategies
+  ///
+  /// Computes the payoff of the profile to each player, and the payoff
+  /// to playing each strategy in the support against the profile.
+  /// The results agree with GetPayoff(pl) and GetPayoff(strategy), and
+  /// the strategy payoffs are indexed in the same way as the profile.
+  /// This is much faster than computing the payoffs one at a time.
+  void GetPayoffs(Vector<T> &p_payoffs, Vector<T> &p_values) const;
+
+  /// \brief Computes all strategy payoffs and cross-player derivatives
+  ///
+  /// Computes the payoff to playing each strategy in the support against
+  /// the profile, and the derivative of each such payoff with respect to
+  /// the probability each other player's strategies are played.  Entry
+  /// (a,b) of the matrix is GetPayoffDeriv(pl, a, b), where a belongs to
+  /// player pl and b to another player; entries for pairs of strategies
+  /// of the same player are zero.  Rows, columns and strategy payoffs are
+  /// indexed in the same way as the profile.
+  void GetPayoffDerivs(Vector<T> &p_values, Matrix<T> &p_derivs) const;
+
+  /// \brief Sets the mixed strategy of one player
+  ///
+  /// Sets the probabilities of the player's strategies in the support,
+  /// in the order they appear in the support, and returns the payoff of
+  /// the resulting profile to each player.  On strategic games, the
+  /// payoff tables contracted along all players' axes but one are kept
+  /// for each player between calls.  When a player changes only some of
+  /// the probabilities, these changes are applied to the other players'
+  /// contractions, so that players may change their strategies in turn
+  /// without the tables being contracted afresh.  A call for a player
+  /// whose contractions are still valid then takes time proportional to
+  /// the length of the profile, to check that the other players'
+  /// probabilities have not been changed otherwise, plus the size of
+  /// the tables divided by the player's number of strategies for each
+  /// probability changed.
+  Vector<T> SetPlayerStrategy(int pl, const Vector<T> &p_probs);
+
   /// \brief Computes the Lyapunov value of the profile
   ///
   /// Computes the Lyapunov value of the profile.  This is a nonnegative
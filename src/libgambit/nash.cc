@@ -66,6 +66,13 @@ MixedStrategyDetailRenderer<T>::Render(const MixedStrategyProfile<T> &p_profile,
   }
 }
 
+template <class T> void
+MixedStrategyBinaryRenderer<T>::Render(const MixedStrategyProfile<T> &p_profile,
+				       const std::string &p_label) const
+{
+  WriteBinaryProfile(m_stream, p_label, (const Vector<T> &) p_profile);
+}
+
 template <class T>
 void BehavStrategyCSVRenderer<T>::Render(const MixedBehaviorProfile<T> &p_profile,
 					 const std::string &p_label) const
@@ -153,6 +160,51 @@ BehavStrategyDetailRenderer<T>::Render(const MixedBehaviorProfile<T> &p_profile,
   }
 }
 
+template <class T>
+void BehavStrategyBinaryRenderer<T>::Render(const MixedBehaviorProfile<T> &p_profile,
+					    const std::string &p_label) const
+{
+  WriteBinaryProfile(m_stream, p_label, p_profile);
+}
+
+namespace {
+
+void WriteLength(std::ostream &p_stream, unsigned int p_length)
+{
+  p_stream.write(reinterpret_cast<const char *>(&p_length), sizeof(p_length));
+}
+
+void WriteProb(std::ostream &p_stream, const double &p_prob)
+{
+  p_stream.write(reinterpret_cast<const char *>(&p_prob), sizeof(p_prob));
+}
+
+void WriteProb(std::ostream &p_stream, const Rational &p_prob)
+{
+  std::string text = lexical_cast<std::string>(p_prob);
+  WriteLength(p_stream, text.length());
+  p_stream.write(text.data(), text.length());
+}
+
+}  // end anonymous namespace
+
+template <class T> void WriteBinaryProfile(std::ostream &p_stream,
+					   const std::string &p_label,
+					   const Vector<T> &p_probs)
+{
+  WriteLength(p_stream, p_label.length());
+  p_stream.write(p_label.data(), p_label.length());
+  WriteLength(p_stream, p_probs.Length());
+  for (int i = 1; i <= p_probs.Length(); i++) {
+    WriteProb(p_stream, p_probs[i]);
+  }
+}
+
+template void WriteBinaryProfile(std::ostream &, const std::string &,
+				 const Vector<double> &);
+template void WriteBinaryProfile(std::ostream &, const std::string &,
+				 const Vector<Rational> &);
+
 template class MixedStrategyRenderer<double>;
 template class MixedStrategyRenderer<Rational>;
 
@@ -165,6 +217,9 @@ template class MixedStrategyCSVRenderer<Rational>;
 template class MixedStrategyDetailRenderer<double>;
 template class MixedStrategyDetailRenderer<Rational>;
 
+template class MixedStrategyBinaryRenderer<double>;
+template class MixedStrategyBinaryRenderer<Rational>;
+
 template class StrategyProfileRenderer<double>;
 template class StrategyProfileRenderer<Rational>;
 
@@ -177,11 +232,14 @@ template class BehavStrategyCSVRenderer<Rational>;
 template class BehavStrategyDetailRenderer<double>;
 template class BehavStrategyDetailRenderer<Rational>;
 
+template class BehavStrategyBinaryRenderer<double>;
+template class BehavStrategyBinaryRenderer<Rational>;
+
 
 
 template <class T>
 NashStrategySolver<T>::NashStrategySolver(shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium /* = 0 */)
-  : m_onEquilibrium(p_onEquilibrium)
+  : m_onEquilibrium(p_onEquilibrium), m_streaming(false)
 {
   if (m_onEquilibrium.get() == 0) {
     m_onEquilibrium = new MixedStrategyNullRenderer<T>();
@@ -190,7 +248,7 @@ NashStrategySolver<T>::NashStrategySolver(shared_ptr<StrategyProfileRenderer<T>
 
 template <class T>
 NashBehavSolver<T>::NashBehavSolver(shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium /* = 0 */)
-  : m_onEquilibrium(p_onEquilibrium)
+  : m_onEquilibrium(p_onEquilibrium), m_streaming(false)
 {
   if (m_onEquilibrium.get() == 0) {
     m_onEquilibrium = new BehavStrategyNullRenderer<T>();
@@ -444,13 +502,14 @@ SubgameNashBehavSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
 
   List<MixedBehaviorProfile<T> > solutions;
   for (int i = 1; i <= vectors.Length(); i++) {
-    solutions.Append(MixedBehaviorProfile<T>(p_support));
+    MixedBehaviorProfile<T> profile(p_support);
     for (int j = 1; j <= vectors[i].Length(); j++) {
-      solutions[i][j] = vectors[i][j];
+      profile[j] = vectors[i][j];
+    }
+    this->m_onEquilibrium->Render(profile);
+    if (!this->m_streaming) {
+      solutions.Append(profile);
     }
-  }
-  for (int i = 1; i <= solutions.Length(); i++) {
-    this->m_onEquilibrium->Render(solutions[i]);
   }
   return solutions;
 }
@@ -91,6 +91,23 @@ private:
   int m_numDecimals;
 };
 
+//
+// Renders mixed strategy profiles in a compact binary format, for programs
+// consuming equilibria as they are found.  See WriteBinaryProfile() for
+// the layout of a record.
+//
+template <class T>
+class MixedStrategyBinaryRenderer : public MixedStrategyRenderer<T> {
+public:
+  MixedStrategyBinaryRenderer(std::ostream &p_stream) : m_stream(p_stream) { }
+  virtual ~MixedStrategyBinaryRenderer() { }
+  virtual void Render(const MixedStrategyProfile<T> &p_profile,
+		      const std::string &p_label = "NE") const;
+
+private:
+  std::ostream &m_stream;
+};
+
 //
 // Encapsulates the rendering of a behavior profile to various text formats.
 //
@@ -140,6 +157,30 @@ private:
   int m_numDecimals;
 };
 
+template <class T>
+class BehavStrategyBinaryRenderer : public BehavStrategyRenderer<T> {
+public:
+  BehavStrategyBinaryRenderer(std::ostream &p_stream) : m_stream(p_stream) { }
+  virtual ~BehavStrategyBinaryRenderer() { }
+  virtual void Render(const MixedBehaviorProfile<T> &p_profile,
+		      const std::string &p_label = "NE") const;
+
+private:
+  std::ostream &m_stream;
+};
+
+/// \brief Writes a profile as a binary record
+///
+/// The record consists of the length of the label and its characters,
+/// followed by the number of probabilities and the probabilities, in
+/// the order of the CSV format.  Lengths are 32-bit unsigned integers,
+/// and floating-point probabilities are 64-bit IEEE doubles, both in the
+/// byte order of the machine writing them.  Rational probabilities are
+/// written in text, each preceded by its length.
+template <class T> void WriteBinaryProfile(std::ostream &p_stream,
+					   const std::string &p_label,
+					   const Vector<T> &p_probs);
+
 //------------------------------------------------------------------------
 //                      Algorithm base classes
 //------------------------------------------------------------------------
@@ -153,8 +194,15 @@ public:
 
   virtual List<MixedStrategyProfile<T> > Solve(const Game &) const = 0;
 
+  /// Sets whether equilibria are only passed to the renderer as they are
+  /// found.  Solve() then returns an empty list, so memory use does not
+  /// grow with the number of equilibria.
+  void SetStreaming(bool p_streaming) { m_streaming = p_streaming; }
+  bool IsStreaming(void) const { return m_streaming; }
+
 protected:
   shared_ptr<StrategyProfileRenderer<T> > m_onEquilibrium;
+  bool m_streaming;
 };
 
 template <class T> class NashBehavSolver {
@@ -164,8 +212,15 @@ public:
 
   virtual List<MixedBehaviorProfile<T> > Solve(const BehaviorSupportProfile &) const = 0;
 
+  /// Sets whether equilibria are only passed to the renderer as they are
+  /// found.  Solve() then returns an empty list, so memory use does not
+  /// grow with the number of equilibria.
+  void SetStreaming(bool p_streaming) { m_streaming = p_streaming; }
+  bool IsStreaming(void) const { return m_streaming; }
+
 protected:
   shared_ptr<StrategyProfileRenderer<T> > m_onEquilibrium;
+  bool m_streaming;
 };
 
 //
@@ -25,34 +25,106 @@
 
 namespace Gambit {
 
-/// This simple class stores a numerical datum.
+/// \brief A numerical datum, such as a payoff or a chance probability
+///
+/// The value is stored both exactly and as a double.  The text from
+/// which the value was set is kept only when it differs from the
+/// canonical text of the rational value (for example, "1.5" rather
+/// than "3/2"); otherwise the text is generated each time it is
+/// requested, and is not stored.  Plain
+/// integers, by far the most common case in game files, are parsed
+/// without going through the general rational parser.
 class Number {
 private:
-  std::string m_text;
   Rational m_rational;
   double m_double;
+  /// Text from which the value was set, or null if canonical
+  std::string *m_text;
+
+  /// Parses text which is the canonical form of a small integer
+  static bool ParseInteger(const std::string &p_text, long &p_value)
+  {
+    std::string::size_type i = 0, length = p_text.length();
+    bool negative = (length > 0 && p_text[0] == '-');
+    if (negative)  i++;
+    if (i == length || length - i > 9 ||
+	(p_text[i] == '0' && (negative || length - i > 1))) {
+      return false;
+    }
+    p_value = 0;
+    for (; i < length; i++) {
+      if (p_text[i] < '0' || p_text[i] > '9')  return false;
+      p_value = 10 * p_value + (p_text[i] - '0');
+    }
+    if (negative)  p_value = -p_value;
+    return true;
+  }
 
 public:
   Number(void)
-    : m_text("0"), m_rational(0), m_double(0.0) { }
+    : m_rational(0), m_double(0.0), m_text(0) { }
   Number(const std::string &p_text)
-    : m_text(p_text), m_rational(lexical_cast<Rational>(p_text)), 
-      m_double((double) m_rational)
+    : m_rational(0), m_double(0.0), m_text(0)
+  { *this = p_text; }
+  /// Sets the value directly, without any text being parsed
+  explicit Number(long p_value)
+    : m_rational(p_value), m_double((double) p_value), m_text(0) { }
+  /// Sets the value directly, without any text being parsed
+  explicit Number(const Rational &p_rational)
+    : m_rational(p_rational), m_double((double) p_rational), m_text(0) { }
+  /// Sets the value directly, together with the (non-canonical) text
+  /// from which it was originally set
+  Number(const Rational &p_rational, const std::string &p_text)
+    : m_rational(p_rational), m_double((double) p_rational),
+      m_text(new std::string(p_text)) { }
+  Number(const Number &p_number)
+    : m_rational(p_number.m_rational), m_double(p_number.m_double),
+      m_text((p_number.m_text) ? new std::string(*p_number.m_text) : 0)
   { }
+  ~Number()  { delete m_text; }
+
+  Number &operator=(const Number &p_number)
+  {
+    if (this != &p_number) {
+      m_rational = p_number.m_rational;
+      m_double = p_number.m_double;
+      delete m_text;
+      m_text = (p_number.m_text) ? new std::string(*p_number.m_text) : 0;
+    }
+    return *this;
+  }
   
   Number &operator=(const std::string &p_text)
   {
+    long value;
+    if (ParseInteger(p_text, value)) {
+      m_rational = Rational(value);
+      m_double = (double) value;
+      delete m_text;
+      m_text = 0;
+      return *this;
+    }
     // We call lexical_cast<Rational>() first because it throws a ValueException
     // if the conversion of the text fails
     m_rational = lexical_cast<Rational>(p_text);
-    m_text = p_text;
     m_double = (double) m_rational;
+    if (p_text == lexical_cast<std::string>(m_rational)) {
+      delete m_text;
+      m_text = 0;
+    }
+    else if (m_text) {
+      *m_text = p_text;
+    }
+    else {
+      m_text = new std::string(p_text);
+    }
     return *this; 
   }
 
   operator const double &(void) const { return m_double; }
   operator const Rational &(void) const { return m_rational; }
-  operator const std::string &(void) const { return m_text; }
+  operator std::string(void) const
+  { return (m_text) ? *m_text : lexical_cast<std::string>(m_rational); }
 };
 
 }
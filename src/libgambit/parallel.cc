@@ -0,0 +1,380 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/libgambit/parallel.cc
+// Running independent pieces of a computation on several threads
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <vector>
+#include <new>
+
+#include "parallel.h"
+#include "sqmatrix.h"
+#include "nash.h"
+
+#ifdef HAVE_PTHREAD
+#include <unistd.h>
+#endif  // HAVE_PTHREAD
+
+namespace Gambit {
+
+//========================================================================
+//                             class Mutex
+//========================================================================
+
+#ifdef HAVE_PTHREAD
+
+Mutex::Mutex(void)    { pthread_mutex_init(&m_mutex, 0); }
+Mutex::~Mutex()       { pthread_mutex_destroy(&m_mutex); }
+void Mutex::Lock(void)   { pthread_mutex_lock(&m_mutex); }
+void Mutex::Unlock(void) { pthread_mutex_unlock(&m_mutex); }
+
+#else
+
+Mutex::Mutex(void)    { }
+Mutex::~Mutex()       { }
+void Mutex::Lock(void)   { }
+void Mutex::Unlock(void) { }
+
+#endif  // HAVE_PTHREAD
+
+//========================================================================
+//                        Running parallel tasks
+//========================================================================
+
+int GetDefaultThreads(void)
+{
+#ifdef HAVE_PTHREAD
+  long processors = sysconf(_SC_NPROCESSORS_ONLN);
+  return (processors > 0) ? (int) processors : 1;
+#else
+  return 1;
+#endif  // HAVE_PTHREAD
+}
+
+#ifdef HAVE_PTHREAD
+
+namespace {
+
+//
+// A copy of an exception thrown by a piece, kept until it can be thrown
+// again on the calling thread
+//
+class StoredException {
+public:
+  virtual ~StoredException() { }
+  virtual void Rethrow(void) const = 0;
+};
+
+template <class E> class StoredExceptionOf : public StoredException {
+private:
+  E m_exception;
+
+public:
+  StoredExceptionOf(const E &p_exception) : m_exception(p_exception) { }
+  virtual ~StoredExceptionOf() { }
+  void Rethrow(void) const { throw m_exception; }
+};
+
+template <class E> StoredException *StoreException(const E &p_exception)
+{ return new StoredExceptionOf<E>(p_exception); }
+
+//
+// Copies the exception being handled.  The library's own exception
+// classes are copied as their own type, so that callers can catch them
+// as they would if the piece had run on their thread; other exceptions
+// are copied as an Exception with the same message.
+//
+StoredException *StoreCurrentException(void)
+{
+  try {
+    throw;
+  }
+  catch (IndexException &e)  { return StoreException(e); }
+  catch (RangeException &e)  { return StoreException(e); }
+  catch (DimensionException &e)  { return StoreException(e); }
+  catch (ValueException &e)  { return StoreException(e); }
+  catch (AssertionException &e)  { return StoreException(e); }
+  catch (ZeroDivideException &e)  { return StoreException(e); }
+  catch (NullException &e)  { return StoreException(e); }
+  catch (InvalidObjectException &e)  { return StoreException(e); }
+  catch (UndefinedException &e)  { return StoreException(e); }
+  catch (MismatchException &e)  { return StoreException(e); }
+  catch (InvalidFileException &e)  { return StoreException(e); }
+  catch (SingularMatrixException &e)  { return StoreException(e); }
+  catch (NashEquilibriumLimitReached &e)  { return StoreException(e); }
+  catch (std::bad_alloc &e)  { return StoreException(e); }
+  catch (std::exception &e)  { return StoreException(Exception(e.what())); }
+  catch (...) {
+    return StoreException(Exception("Unknown error in parallel computation"));
+  }
+}
+
+//
+// The state shared by the threads running a task.  All members other
+// than the task itself are protected by the mutex; the condition is
+// signalled whenever a piece has been run.
+//
+class TaskScheduler {
+public:
+  ParallelTask &m_task;
+  int m_pieces, m_next;
+  std::vector<bool> m_done;
+  bool m_stop, m_failed;
+  /// The exception thrown by the first piece to fail
+  StoredException *m_error;
+  pthread_mutex_t m_mutex;
+  pthread_cond_t m_ran;
+
+  TaskScheduler(ParallelTask &p_task, int p_pieces)
+    : m_task(p_task), m_pieces(p_pieces), m_next(0), m_done(p_pieces, false),
+      m_stop(false), m_failed(false), m_error(0)
+  {
+    pthread_mutex_init(&m_mutex, 0);
+    pthread_cond_init(&m_ran, 0);
+  }
+  ~TaskScheduler()
+  {
+    delete m_error;
+    pthread_cond_destroy(&m_ran);
+    pthread_mutex_destroy(&m_mutex);
+  }
+
+  /// Returns the next piece to run, or -1 if there is none
+  int Claim(void)
+  {
+    pthread_mutex_lock(&m_mutex);
+    int piece = (m_stop || m_next >= m_pieces) ? -1 : m_next++;
+    pthread_mutex_unlock(&m_mutex);
+    return piece;
+  }
+
+  /// Runs a claimed piece, and records that it has been run
+  void Execute(int p_piece)
+  {
+    StoredException *error = 0;
+    try {
+      m_task.Run(p_piece);
+    }
+    catch (...) {
+      error = StoreCurrentException();
+    }
+
+    pthread_mutex_lock(&m_mutex);
+    if (error && !m_failed) {
+      m_failed = true;
+      m_error = error;
+    }
+    else {
+      delete error;
+    }
+    m_stop = m_stop || (error != 0);
+    m_done[p_piece] = true;
+    pthread_cond_broadcast(&m_ran);
+    pthread_mutex_unlock(&m_mutex);
+  }
+
+  /// Stops starting new pieces
+  void Stop(void)
+  {
+    pthread_mutex_lock(&m_mutex);
+    m_stop = true;
+    pthread_mutex_unlock(&m_mutex);
+  }
+};
+
+//
+// The threads which help run the pieces of tasks.  They are started as
+// they are first needed, and then wait for further tasks rather than
+// exiting, so that a computation running many small tasks in turn does
+// not start and stop threads for each one.  The pool serves one task at
+// a time; a task started while another is running, for instance from
+// within one of its pieces, is run serially by the thread starting it.
+// The pool is never destroyed, as its threads may still be waiting on
+// it when the program exits.
+//
+class ThreadPool {
+private:
+  pthread_mutex_t m_mutex;
+  /// Signalled when a task is posted
+  pthread_cond_t m_posted;
+  /// Signalled when the last thread running a task's pieces leaves it
+  pthread_cond_t m_left;
+  int m_threads;
+  bool m_busy;
+  /// The task being served, and the number of threads wanted for it,
+  /// which have joined it, and which are still running its pieces
+  TaskScheduler *m_task;
+  int m_wanted, m_joined, m_active;
+
+  static void *Serve(void *p_pool)
+  {
+    static_cast<ThreadPool *>(p_pool)->Serve();
+    return 0;
+  }
+  void Serve(void);
+
+public:
+  ThreadPool(void)
+    : m_threads(0), m_busy(false), m_task(0),
+      m_wanted(0), m_joined(0), m_active(0)
+  {
+    pthread_mutex_init(&m_mutex, 0);
+    pthread_cond_init(&m_posted, 0);
+    pthread_cond_init(&m_left, 0);
+  }
+
+  /// Claims the pool for the task, with up to p_helpers threads helping
+  /// the calling thread; returns false if the pool is serving another
+  bool Post(TaskScheduler &p_task, int p_helpers);
+  /// Waits for the threads running the posted task to leave it, and
+  /// releases the pool
+  void Withdraw(void);
+};
+
+void ThreadPool::Serve(void)
+{
+  pthread_mutex_lock(&m_mutex);
+  while (true) {
+    while (!m_task || m_joined >= m_wanted) {
+      pthread_cond_wait(&m_posted, &m_mutex);
+    }
+    TaskScheduler *task = m_task;
+    m_joined++;
+    m_active++;
+    pthread_mutex_unlock(&m_mutex);
+
+    int piece;
+    while ((piece = task->Claim()) >= 0) {
+      task->Execute(piece);
+    }
+
+    pthread_mutex_lock(&m_mutex);
+    if (--m_active == 0) {
+      pthread_cond_broadcast(&m_left);
+    }
+  }
+}
+
+bool ThreadPool::Post(TaskScheduler &p_task, int p_helpers)
+{
+  pthread_mutex_lock(&m_mutex);
+  if (m_busy) {
+    pthread_mutex_unlock(&m_mutex);
+    return false;
+  }
+  m_busy = true;
+  while (m_threads < p_helpers) {
+    pthread_t thread;
+    if (pthread_create(&thread, 0, ThreadPool::Serve, this) != 0)  break;
+    pthread_detach(thread);
+    m_threads++;
+  }
+  m_task = &p_task;
+  m_wanted = p_helpers;
+  m_joined = 0;
+  pthread_cond_broadcast(&m_posted);
+  pthread_mutex_unlock(&m_mutex);
+  return true;
+}
+
+void ThreadPool::Withdraw(void)
+{
+  pthread_mutex_lock(&m_mutex);
+  m_task = 0;
+  while (m_active > 0) {
+    pthread_cond_wait(&m_left, &m_mutex);
+  }
+  m_busy = false;
+  pthread_mutex_unlock(&m_mutex);
+}
+
+ThreadPool &GetThreadPool(void)
+{
+  static ThreadPool *pool = new ThreadPool;
+  return *pool;
+}
+
+}  // end anonymous namespace
+
+void RunParallel(ParallelTask &p_task, int p_pieces, int p_threads)
+{
+  if (p_threads <= 0)  p_threads = GetDefaultThreads();
+  if (p_threads > p_pieces)  p_threads = p_pieces;
+
+  TaskScheduler scheduler(p_task, p_pieces);
+  if (p_threads <= 1 || !GetThreadPool().Post(scheduler, p_threads - 1)) {
+    for (int piece = 0; piece < p_pieces; piece++) {
+      p_task.Run(piece);
+      if (!p_task.Finish(piece))  break;
+    }
+    return;
+  }
+
+  // The calling thread finishes pieces in order, and helps run pieces
+  // while the next one to finish is not yet available
+  try {
+    for (int finish = 0; finish < p_pieces; ) {
+      pthread_mutex_lock(&scheduler.m_mutex);
+      if (scheduler.m_failed) {
+	pthread_mutex_unlock(&scheduler.m_mutex);
+	break;
+      }
+      else if (scheduler.m_done[finish]) {
+	pthread_mutex_unlock(&scheduler.m_mutex);
+	if (!p_task.Finish(finish++)) {
+	  break;
+	}
+      }
+      else if (scheduler.m_next < p_pieces && !scheduler.m_stop) {
+	int piece = scheduler.m_next++;
+	pthread_mutex_unlock(&scheduler.m_mutex);
+	scheduler.Execute(piece);
+      }
+      else {
+	pthread_cond_wait(&scheduler.m_ran, &scheduler.m_mutex);
+	pthread_mutex_unlock(&scheduler.m_mutex);
+      }
+    }
+  }
+  catch (...) {
+    scheduler.Stop();
+    GetThreadPool().Withdraw();
+    throw;
+  }
+
+  scheduler.Stop();
+  GetThreadPool().Withdraw();
+  if (scheduler.m_failed) {
+    scheduler.m_error->Rethrow();
+  }
+}
+
+#else
+
+void RunParallel(ParallelTask &p_task, int p_pieces, int)
+{
+  for (int piece = 0; piece < p_pieces; piece++) {
+    p_task.Run(piece);
+    if (!p_task.Finish(piece))  break;
+  }
+}
+
+#endif  // HAVE_PTHREAD
+
+}  // end namespace Gambit
@@ -0,0 +1,128 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/libgambit/parallel.h
+// Running independent pieces of a computation on several threads
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef LIBGAMBIT_PARALLEL_H
+#define LIBGAMBIT_PARALLEL_H
+
+#include "libgambit.h"
+
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif  // HAVE_PTHREAD
+
+namespace Gambit {
+
+///
+/// A lock protecting data shared between the threads of a parallel
+/// computation.  When Gambit is built without thread support, locking
+/// does nothing.
+///
+class Mutex {
+private:
+#ifdef HAVE_PTHREAD
+  pthread_mutex_t m_mutex;
+#endif  // HAVE_PTHREAD
+
+  Mutex(const Mutex &);
+  Mutex &operator=(const Mutex &);
+
+public:
+  Mutex(void);
+  ~Mutex();
+
+  void Lock(void);
+  void Unlock(void);
+};
+
+///
+/// Holds a mutex locked for as long as the object exists
+///
+class MutexLock {
+private:
+  Mutex &m_mutex;
+
+  MutexLock(const MutexLock &);
+  MutexLock &operator=(const MutexLock &);
+
+public:
+  MutexLock(Mutex &p_mutex) : m_mutex(p_mutex) { m_mutex.Lock(); }
+  ~MutexLock() { m_mutex.Unlock(); }
+};
+
+///
+/// Releases a mutex held by the calling thread for as long as the object
+/// exists, so that work not needing the lock can be done within the
+/// scope of a MutexLock
+///
+class MutexUnlock {
+private:
+  Mutex &m_mutex;
+
+  MutexUnlock(const MutexUnlock &);
+  MutexUnlock &operator=(const MutexUnlock &);
+
+public:
+  MutexUnlock(Mutex &p_mutex) : m_mutex(p_mutex) { m_mutex.Unlock(); }
+  ~MutexUnlock() { m_mutex.Lock(); }
+};
+
+///
+/// A computation divided into a number of pieces, numbered from zero,
+/// which can be run in any order and concurrently.  Run() is called
+/// on an arbitrary thread; it must not touch data used by other pieces
+/// (including the reference counts of shared game objects) without
+/// locking.  Finish() is called on the thread which started the
+/// computation, for each piece in order, as soon as that piece and all
+/// earlier ones have been run, so that results can be reported in the
+/// same order as a serial computation would report them.
+///
+class ParallelTask {
+public:
+  virtual ~ParallelTask() { }
+
+  /// Runs the piece
+  virtual void Run(int p_piece) = 0;
+  /// Reports the results of the piece; returning false skips all
+  /// pieces not yet started, and finishes no further pieces
+  virtual bool Finish(int p_piece) { return true; }
+};
+
+/// Returns the number of threads to use when none is specified, which
+/// is the number of processors available
+int GetDefaultThreads(void);
+
+/// \brief Runs all the pieces of a task
+///
+/// Runs the pieces of the task using up to p_threads threads, including
+/// the calling thread, or the default number of threads if p_threads is
+/// not positive.  The threads other than the calling one are kept between
+/// calls.  A task run while another is running, such as from within one
+/// of its pieces or from Finish(), is run serially on the calling thread.  If running a piece throws an exception, no further
+/// pieces are started, and the exception is thrown again once the pieces
+/// already started have completed.  Exceptions of the library's own
+/// classes keep their type; others are thrown as an Exception with the
+/// same message.
+void RunParallel(ParallelTask &p_task, int p_pieces, int p_threads = 0);
+
+}  // end namespace Gambit
+
+#endif  // LIBGAMBIT_PARALLEL_H
@@ -390,15 +390,12 @@ Rational::fits_in_double() const
 // These were moved from the header file to eliminate warnings
 //
 
-static IntegerRep _ZeroRep = {1, 0, 1, {0}};
-static IntegerRep _OneRep = {1, 0, 1, {1}};
-
-Rational::Rational() : num(&_ZeroRep), den(&_OneRep) {}
+Rational::Rational() : num(0), den(1) {}
 Rational::~Rational() {}
 
 Rational::Rational(const Rational& y) :num(y.num), den(y.den) {}
 
-Rational::Rational(const Integer& n) :num(n), den(&_OneRep) {}
+Rational::Rational(const Integer& n) :num(n), den(1) {}
 
 Rational::Rational(const Integer& n, const Integer& d) 
  : num(n), den(d)
@@ -409,9 +406,9 @@ Rational::Rational(const Integer& n, const Integer& d)
   normalize();
 }
 
-Rational::Rational(long n) :num(n), den(&_OneRep) { }
+Rational::Rational(long n) :num(n), den(1) { }
 
-Rational::Rational(int n) :num(n), den(&_OneRep) { }
+Rational::Rational(int n) :num(n), den(1) { }
 
 Rational::Rational(long n, long d) 
  : num(n), den(d)
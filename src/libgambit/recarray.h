@@ -187,19 +187,27 @@ RectArray<T> &RectArray<T>::operator=(const RectArray<T> &a)
 {
   if (this != &a)   {
     int i;
-    for (i = minrow; i <= maxrow; i++)
-      if (data[i])  delete [] (data[i] + mincol);
-    if (data)  delete [] (data + minrow);
-
-    minrow = a.minrow;
-    maxrow = a.maxrow;
-    mincol = a.mincol;
-    maxcol = a.maxcol;
+    // As with Array, we only reallocate if the dimensions differ, so
+    // that repeatedly assigning matrices of the same shape (for
+    // example, when restoring a tableau) reuses the existing storage
+    if (minrow != a.minrow || maxrow != a.maxrow ||
+	mincol != a.mincol || maxcol != a.maxcol) {
+      for (i = minrow; i <= maxrow; i++)
+	if (data[i])  delete [] (data[i] + mincol);
+      if (data)  delete [] (data + minrow);
+
+      minrow = a.minrow;
+      maxrow = a.maxrow;
+      mincol = a.mincol;
+      maxcol = a.maxcol;
     
-    data = (maxrow >= minrow) ? new T *[maxrow - minrow + 1] - minrow : 0;
+      data = (maxrow >= minrow) ? new T *[maxrow - minrow + 1] - minrow : 0;
+      for (i = minrow; i <= maxrow; i++)  {
+	data[i] = (maxcol >= mincol) ? new T[maxcol - mincol + 1] - mincol : 0;
+      }
+    }
   
     for (i = minrow; i <= maxrow; i++)  {
-      data[i] = (maxcol >= mincol) ? new T[maxcol - mincol + 1] - mincol : 0;
       for (int j = mincol; j <= maxcol; j++)
 	data[i][j] = a.data[i][j];
     }
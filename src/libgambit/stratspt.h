@@ -45,6 +45,7 @@ class StrategySupportProfile {
   template <class T> friend class MixedStrategyProfileRep;
   template <class T> friend class AggMixedStrategyProfileRep;
   template <class T> friend class BagentMixedStrategyProfileRep;
+  template <class T> friend class TableMixedStrategyProfileRep;
 protected:
   Game m_nfg;
   Array<Array<GameStrategy> > m_support;
@@ -25,6 +25,7 @@
 
 #include "bfs.h"
 #include "basis.h"
+#include "sparsemat.h"
 
 // ---------------------------------------------------------------------------
 //                          BaseTableau Stuff
@@ -74,6 +75,7 @@ public:
 template <class T> class TableauInterface : public BaseTableau<T>{
 protected:
   const Gambit::Matrix<T> *A;  // should this be private?
+  const SparseMatrix<T> *sparseA;  // used in place of A, if A is null
   const Gambit::Vector<T> *b;  // should this be private?
   Basis basis; 
   Gambit::Vector<T> solution;  // current solution vector. should this be private?
@@ -85,6 +87,7 @@ public:
   TableauInterface(const Gambit::Matrix<T> &A, const Gambit::Vector<T> &b); 
   TableauInterface(const Gambit::Matrix<T> &A, const Gambit::Array<int> &art, 
 		   const Gambit::Vector<T> &b); 
+  TableauInterface(const SparseMatrix<T> &A, const Gambit::Vector<T> &b); 
   TableauInterface(const TableauInterface<T>&);
   virtual ~TableauInterface();
 
@@ -98,8 +101,15 @@ public:
   int MaxCol() const;
 
   Basis & GetBasis(void);
+  const Basis & GetBasis(void) const;
+  bool IsSparse(void) const { return (A == 0); }
   const Gambit::Matrix<T> & Get_A(void) const;
+  const SparseMatrix<T> & Get_SparseA(void) const;
   const Gambit::Vector<T> & Get_b(void) const;
+  // replace the constraint matrix with one of the same dimensions;
+  // the tableau must be refactored before it is used again
+  void Set_A(const Gambit::Matrix<T> &);
+  void Set_A(const SparseMatrix<T> &);
   
   bool Member(int i) const;
   int Label(int i) const;   // return variable in i'th position of Tableau
@@ -114,6 +124,7 @@ public:
   
   virtual void BasisVector(Gambit::Vector<T> &x) const = 0; // solve M x = (*b)
   void GetColumn( int , Gambit::Vector<T> &) const;  // raw column
+  void GetSparseColumn( int , std::map<int, T> &) const;  // nonzeros of raw column
   void GetBasis( Basis & ) const; // return Basis for current Tableau
 
   BFS<T> GetBFS1(void) const; 
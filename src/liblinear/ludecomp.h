@@ -23,7 +23,9 @@
 #ifndef LUDECOMP_H
 #define LUDECOMP_H
 
+#include <vector>
 #include "libgambit/libgambit.h"
+#include "libgambit/parallel.h"
 #include "basis.h"
 
 template <class T> class Tableau;
@@ -32,13 +34,20 @@ template <class T> class Tableau;
 // Class EtaMatrix
 // ---------------------------------------------------------------------------
 
+//
+// An identity matrix with its column col replaced.  Only the nonzero
+// entries of that column are stored, in increasing order of row.
+//
 template <class T> class EtaMatrix {
   public:
   int col;
-  Gambit::Vector<T> etadata;
+  T diag;                     // the entry of the column in row col
+  std::vector<int> rows;      // the rows of the nonzero entries
+  std::vector<T> values;      // and their values, including diag
   
   
-  EtaMatrix(int c, Gambit::Vector<T> &v) : col(c), etadata(v) {};
+  EtaMatrix(int c, const Gambit::Vector<T> &v);
+  EtaMatrix(int c, const std::vector<std::pair<int, T> > &entries);
 
 // required for list class
 bool operator==(const EtaMatrix<T> &) const;
@@ -61,9 +70,11 @@ private:
   Gambit::List< EtaMatrix<T> > U;
   Gambit::List< EtaMatrix<T> > E;
   Gambit::List< int > P;
+  // The columns of the basis, in the order in which they were pivoted on
+  Gambit::Array< int > Q;
 
-  Gambit::Vector<T> scratch1; // scratch vectors so we don't reallocate them
-  Gambit::Vector<T> scratch2; // everytime we do something.
+  Gambit::Vector<T> scratch1; // scratch vector so we don't reallocate it
+                              // everytime we do something.
 
   int refactor_number;
   int iterations;
@@ -71,6 +82,9 @@ private:
 
   const LUdecomp<T> *parent;
   int copycount;
+  // protects copycount, since copies of a decomposition may be
+  // created and destroyed on several threads at once
+  mutable Gambit::Mutex copylock;
 
   // don't use this copy constructor
   LUdecomp( const LUdecomp<T> &a);
@@ -133,6 +147,10 @@ public:
   // if number is < 0, no refactoring is done;
   void SetRefactor( int );
 
+  // true if this is a copy which still relies on the decomposition
+  // it was copied from, that is, one which has not been refactored
+  bool IsCopy() const { return parent != NULL; }
+
   //-------------------
   // Private Members
   //-------------------
@@ -140,12 +158,16 @@ public:
 private:
   
   void FactorBasis();
+  void PermuteQ( Gambit::Vector<T> & ) const;
+  void UnpermuteQ( Gambit::Vector<T> & ) const;
 
-  void GaussElem( Gambit::Matrix<T> &, int, int );
+  void AddCopy() const;
+  void RemoveCopy() const;
 
   bool CheckBasis();
   bool RefactorCheck();
 
+  // These all work in place, touching only the nonzeros of the etas
   void BTransE( Gambit::Vector<T> & ) const;
   void FTransE( Gambit::Vector<T> & ) const;
   void BTransU( Gambit::Vector<T> & ) const;
@@ -153,17 +175,11 @@ private:
   void LPd_Trans( Gambit::Vector<T> & ) const;
   void yLP_Trans( Gambit::Vector<T> & ) const;
 
-  void VectorEtaSolve( const Gambit::Vector<T> &v,  
-		      const EtaMatrix<T> &, 
-		      Gambit::Vector<T> &y ) const;
-
-  void EtaVectorSolve( const Gambit::Vector<T> &v, 
-		      const EtaMatrix<T> &,
-		      Gambit::Vector<T> &d ) const;
-
-  void yLP_mult( const Gambit::Vector<T> &y, int j, Gambit::Vector<T> &) const;
+  void VectorEtaSolve( const EtaMatrix<T> &, Gambit::Vector<T> &y ) const;
+  void EtaVectorSolve( const EtaMatrix<T> &, Gambit::Vector<T> &d ) const;
 
-  void LPd_mult( Gambit::Vector<T> &d, int j, Gambit::Vector<T> &) const;
+  void yLP_mult( Gambit::Vector<T> &y, int j ) const;
+  void LPd_mult( Gambit::Vector<T> &d, int j ) const;
 
 
 };  // end of class LUdecomp
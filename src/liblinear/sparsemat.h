@@ -0,0 +1,92 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/liblinear/sparsemat.h
+// Interface to sparse matrix class
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef SPARSEMAT_H
+#define SPARSEMAT_H
+
+#include <map>
+#include <vector>
+#include "libgambit/libgambit.h"
+
+//
+// A matrix stored by columns, holding only its nonzero entries.  Rows
+// and columns are indexed over arbitrary ranges, as with Gambit::Matrix.
+// Entries set to zero are removed, so the storage used is proportional
+// to the number of nonzero entries.
+//
+template <class T> class SparseMatrix {
+public:
+  typedef std::map<int, T> Column;
+
+private:
+  int m_minrow, m_maxrow, m_mincol;
+  std::vector<Column> m_columns;
+  T m_zero;
+
+  void CheckIndex(int row, int col) const
+  {
+    if (row < m_minrow || row > m_maxrow ||
+	col < m_mincol || col > MaxCol()) {
+      throw Gambit::IndexException();
+    }
+  }
+
+public:
+  /// @name Lifecycle
+  //@{
+  SparseMatrix(int minrow, int maxrow, int mincol, int maxcol)
+    : m_minrow(minrow), m_maxrow(maxrow), m_mincol(mincol),
+      m_columns(maxcol - mincol + 1), m_zero(0) { }
+  //@}
+
+  /// @name General data access
+  //@{
+  int MinRow(void) const { return m_minrow; }
+  int MaxRow(void) const { return m_maxrow; }
+  int MinCol(void) const { return m_mincol; }
+  int MaxCol(void) const { return m_mincol + (int) m_columns.size() - 1; }
+  int NumRows(void) const { return m_maxrow - m_minrow + 1; }
+  int NumColumns(void) const { return m_columns.size(); }
+  /// Returns the number of entries stored, all of which are nonzero
+  int NumNonzeros(void) const;
+  //@}
+
+  /// @name Accessing entries
+  //@{
+  const T &operator()(int row, int col) const;
+  /// Sets an entry, removing it from the storage if it is zero
+  void Set(int row, int col, const T &value);
+  /// Adds to an entry
+  void Add(int row, int col, const T &value);
+  //@}
+
+  /// @name Accessing columns
+  //@{
+  /// The nonzero entries of the column, indexed by row
+  const Column &GetColumn(int col) const
+  { CheckIndex(m_minrow, col);  return m_columns[col - m_mincol]; }
+  /// Copies the column, including its zero entries, into the vector
+  void GetColumn(int col, Gambit::Vector<T> &) const;
+  //@}
+};
+
+#endif   // SPARSEMAT_H
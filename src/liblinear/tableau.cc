@@ -42,6 +42,13 @@ Tableau<double>::Tableau(const Gambit::Matrix<double> &A, const Gambit::Array<in
 }
 
 
+Tableau<double>::Tableau(const SparseMatrix<double> &A, 
+			 const Gambit::Vector<double> &b)
+  : TableauInterface<double>(A,b), B(*this), tmpcol(b.First(),b.Last())
+{
+  Solve(b, solution);
+}
+
 Tableau<double>::Tableau(const Tableau<double> &orig)
   : TableauInterface<double>(orig), B(orig.B,*this), tmpcol(orig.tmpcol)
 { }
@@ -125,7 +132,6 @@ void Tableau<double>::SetConst(const Gambit::Vector<double> &bnew)
   Solve(*b, solution);
 }
 
-//** this function is not currently used.  Drop it?
 void Tableau<double>::SetBasis(const Basis &in)
 {
   basis= in;
@@ -182,6 +188,18 @@ Gambit::Integer find_lcd(const Gambit::Matrix<Gambit::Rational> &mat)
   return lcd;
 }
 
+Gambit::Integer find_lcd(const SparseMatrix<Gambit::Rational> &mat)
+{
+  Gambit::Integer lcd(1);
+  for (int j = mat.MinCol(); j <= mat.MaxCol(); j++) {
+    const SparseMatrix<Gambit::Rational>::Column &column = mat.GetColumn(j);
+    for (SparseMatrix<Gambit::Rational>::Column::const_iterator entry = column.begin();
+	 entry != column.end(); ++entry)
+      lcd = lcm(entry->second.denominator(),lcd);
+  }
+  return lcd;
+}
+
 Gambit::Integer find_lcd(const Gambit::Vector<Gambit::Rational> &vec)
 {
   Gambit::Integer lcd(1);
@@ -255,6 +273,41 @@ Tableau<Gambit::Rational>::Tableau(const Gambit::Matrix<Gambit::Rational> &A,
 }
 
 
+Tableau<Gambit::Rational>::Tableau(const SparseMatrix<Gambit::Rational> &A, 
+			    const Gambit::Vector<Gambit::Rational> &b) 
+  : TableauInterface<Gambit::Rational>(A,b), 
+    Tabdat(A.MinRow(),A.MaxRow(),A.MinCol(),A.MaxCol()),
+    Coeff(b.First(),b.Last()), denom(1), tmpcol(b.First(),b.Last()), 
+    nonbasic(A.MinCol(),A.MaxCol())
+{
+  int j;
+  for(j=MinCol();j<=MaxCol();j++) 
+    nonbasic[j] = j;
+  
+  totdenom = lcm(find_lcd(A),find_lcd(b));
+  if(totdenom<=0) throw BadDenom();
+  
+  for (int i = b.First();i<=b.Last();i++) {
+    Gambit::Rational x = b[i]*(Gambit::Rational)totdenom;
+    if(x.denominator() != 1) throw BadDenom();
+    Coeff[i] = x.numerator();
+  }
+  for (int i = MinRow();i<=MaxRow();i++) 
+    for (j = MinCol();j<=MaxCol();j++) 
+      Tabdat(i,j) = 0;
+  for (j = MinCol();j<=MaxCol();j++) {
+    const SparseMatrix<Gambit::Rational>::Column &column = A.GetColumn(j);
+    for (SparseMatrix<Gambit::Rational>::Column::const_iterator entry = column.begin();
+	 entry != column.end(); ++entry) {
+      Gambit::Rational x = entry->second*(Gambit::Rational)totdenom;
+      if(x.denominator() != 1) throw BadDenom();
+      Tabdat(entry->first,j) = x.numerator();
+    }
+  }
+  for (int i = b.First();i<=b.Last();i++) 
+    solution[i] = (Gambit::Rational)Coeff[i];
+}
+
 Tableau<Gambit::Rational>::Tableau(const Tableau<Gambit::Rational> &orig) 
   : TableauInterface<Gambit::Rational>(orig), Tabdat(orig.Tabdat), Coeff(orig.Coeff), 
     totdenom(orig.totdenom), denom(orig.denom), 
@@ -437,7 +490,7 @@ void Tableau<Gambit::Rational>::Refactor()
   //BigDump(gout);
   //** Note -- we may need to recompute totdenom here, if A and b have changed. 
   //gout << "\ndenom: " << denom << " totdenom: " << totdenom;
-  totdenom = lcm(find_lcd(*A),find_lcd(*b));
+  totdenom = lcm((A) ? find_lcd(*A) : find_lcd(*sparseA),find_lcd(*b));
   if(totdenom<=0) throw BadDenom();
   // gout << "\ndenom: " << denom << " totdenom: " << totdenom;
 
@@ -482,13 +535,23 @@ void Tableau<Gambit::Rational>::SetConst(const Gambit::Vector<Gambit::Rational>
 }
 
 
-//** this function is not currently used.  Drop it?
+// Since the full tableau is held, the new basis is reached by pivoting:
+// each variable in the new basis which is not yet basic is pivoted in,
+// in place of one which is not in the new basis.
 void Tableau<Gambit::Rational>::SetBasis(const Basis &in)
 {
-  basis= in;
-  //** this has to be changed -- Need to start over and pivot to new basis.  
-  // B.refactor();
-  // B.solve(*b, solution);
+  Gambit::Vector<Gambit::Rational> column(MinRow(),MaxRow());
+  for(int i=in.First();i<=in.Last();i++) {
+    int label = in.Label(i);
+    if(Member(label)) continue;
+    MySolveColumn(label,column);
+    int outrow = 0;
+    for(int j=MinRow();j<=MaxRow() && outrow==0;j++) 
+      if(!in.Member(Label(j)) && column[j] != (Gambit::Rational)0) outrow = j;
+    // if there is no such row, the new basis is singular
+    if(outrow == 0) throw BadPivot();
+    Pivot(outrow,label);
+  }
 }
 
  // solve M x = b
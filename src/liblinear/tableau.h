@@ -46,6 +46,7 @@ public:
   Tableau(const Gambit::Matrix<double> &A, const Gambit::Vector<double> &b); 
   Tableau(const Gambit::Matrix<double> &A, const Gambit::Array<int> &art, 
 	  const Gambit::Vector<double> &b); 
+  Tableau(const SparseMatrix<double> &A, const Gambit::Vector<double> &b); 
   Tableau(const Tableau<double>&);
   virtual ~Tableau();
   
@@ -66,6 +67,9 @@ public:
 
   void SetConst(const Gambit::Vector<double> &bnew);
   void SetBasis( const Basis &); // set new Tableau
+  // true if the factorization is shared with the tableau this was copied
+  // from, which must then outlive this tableau
+  bool SharesFactorization() const { return B.IsCopy(); }
   
   bool IsFeasible();
   bool IsLexMin();
@@ -109,6 +113,8 @@ public:
   Tableau(const Gambit::Matrix<Gambit::Rational> &A, const Gambit::Vector<Gambit::Rational> &b); 
   Tableau(const Gambit::Matrix<Gambit::Rational> &A, const Gambit::Array<int> &art, 
 	  const Gambit::Vector<Gambit::Rational> &b); 
+  // the full tableau is dense, whichever form the constraint matrix has
+  Tableau(const SparseMatrix<Gambit::Rational> &A, const Gambit::Vector<Gambit::Rational> &b); 
   Tableau(const Tableau<Gambit::Rational>&);
   virtual ~Tableau();
   
@@ -127,6 +133,8 @@ public:
 
   void SetConst(const Gambit::Vector<Gambit::Rational> &bnew);
   void SetBasis( const Basis &); // set new Tableau
+  // the full tableau is always held, so nothing is shared with copies
+  bool SharesFactorization() const { return false; }
   void Solve(const Gambit::Vector<Gambit::Rational> &b, Gambit::Vector<Gambit::Rational> &x);  // solve M x = b
   void SolveT(const Gambit::Vector<Gambit::Rational> &c, Gambit::Vector<Gambit::Rational> &y);  // solve y M = c
   
@@ -50,7 +50,7 @@ cdef extern from "libgambit/rational.h":
 
 cdef extern from "libgambit/number.h":
     cdef cppclass c_Number "Number":
-        cxx_string as_string "operator const string &"()
+        cxx_string as_string "operator string"()
      
 cdef extern from "libgambit/array.h":
     cdef cppclass Array[T]: 
@@ -355,6 +355,8 @@ cdef extern from "util.h":
     cxx_string WriteGame(c_StrategySupportProfile) except +IOError
 
     void setitem_ArrayInt(Array[int] *, int, int)
+    void setitem_ArrayDouble(Array[double] *, int, double)
+    void setitem_ArrayRational(Array[c_Rational] *, int, char *)
     void setitem_MixedStrategyProfileDouble(c_MixedStrategyProfileDouble *, 
                                             int, double)
     void setitem_MixedStrategyProfileDoubleStrategy(c_MixedStrategyProfileDouble *, 
@@ -363,6 +365,10 @@ cdef extern from "util.h":
                                             int, char *)
     void setitem_MixedStrategyProfileRationalStrategy(c_MixedStrategyProfileRational *, 
                                             c_GameStrategy, char *)
+    Array[double] setplayer_MixedStrategyProfileDouble(c_MixedStrategyProfileDouble *,
+                                            int, Array[double] *) except +ValueError
+    Array[c_Rational] setplayer_MixedStrategyProfileRational(c_MixedStrategyProfileRational *,
+                                            int, Array[c_Rational] *) except +ValueError
     void setitem_MixedBehaviorProfileDouble(c_MixedBehaviorProfileDouble *, 
                                             int, double)
     void setitem_MixedBehaviorProfileRational(c_MixedBehaviorProfileRational *, 
@@ -152,6 +152,24 @@ cdef class MixedStrategyProfile(object):
                             strategy2.__class__.__name__)
         return self._strategy_value_deriv((<Player>player).player.deref().GetNumber(), strategy1, strategy2)
 
+    def set_player_strategy(self, player, probs):
+        """
+        Sets the probabilities of the strategies of 'player' to 'probs',
+        and returns the list of payoffs to all players.  Iterative methods
+        which change one player's strategy at a time should use this
+        rather than setting each probability and computing the payoffs.
+        """
+        if isinstance(player, (int, str)):
+            player = self.game.players[player]
+        elif not isinstance(player, Player):
+            raise TypeError("player index must be int, str, or Player, not %s" %
+                            player.__class__.__name__)
+        if len(probs) != len(player.strategies):
+            raise ValueError("player has %d strategies, but %d probabilities given" %
+                             (len(player.strategies), len(probs)))
+        return self._set_player_strategy((<Player>player).player.deref().GetNumber(),
+                                         probs)
+
     def set_centroid(self):   self.profile.SetCentroid()
     def normalize(self):      self.profile.Normalize()
 
@@ -181,6 +199,17 @@ cdef class MixedStrategyProfileDouble(MixedStrategyProfile):
     def _strategy_value_deriv(self, int pl,
                               Strategy s1, Strategy s2):
         return self.profile.GetPayoffDeriv(pl, s1.strategy, s2.strategy)
+    def _set_player_strategy(self, int pl, probs):
+        cdef Array[double] *p
+        cdef Array[double] payoffs
+        p = new Array[double](len(probs))
+        for i in xrange(1, len(probs)+1):
+            setitem_ArrayDouble(p, i, probs[i-1])
+        try:
+            payoffs = setplayer_MixedStrategyProfileDouble(self.profile, pl, p)
+        finally:
+            del p
+        return [ payoffs.getitem(i) for i in xrange(1, payoffs.Length()+1) ]
 
     def liap_value(self):
         return self.profile.GetLiapValue()
@@ -253,6 +282,24 @@ cdef class MixedStrategyProfileRational(MixedStrategyProfile):
     def _strategy_value_deriv(self, int pl,
                               Strategy s1, Strategy s2):
         return Rational(rat_str(self.profile.GetPayoffDeriv(pl, s1.strategy, s2.strategy)).c_str())
+    def _set_player_strategy(self, int pl, probs):
+        cdef Array[c_Rational] *p
+        cdef Array[c_Rational] payoffs
+        cdef char *s
+        p = new Array[c_Rational](len(probs))
+        try:
+            for i in xrange(1, len(probs)+1):
+                if not isinstance(probs[i-1], (int, fractions.Fraction)):
+                    raise TypeError("rational precision profile requires int or Fraction probability, not %s" %
+                                    probs[i-1].__class__.__name__)
+                t = str(probs[i-1])
+                s = t
+                setitem_ArrayRational(p, i, s)
+            payoffs = setplayer_MixedStrategyProfileRational(self.profile, pl, p)
+        finally:
+            del p
+        return [ Rational(rat_str(payoffs.getitem(i)).c_str())
+                 for i in xrange(1, payoffs.Length()+1) ]
 
     def liap_value(self):
         return Rational(rat_str(self.profile.GetLiapValue()).c_str())
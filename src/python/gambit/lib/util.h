@@ -66,6 +66,13 @@ std::string WriteGame(const StrategySupportProfile &p_support)
 inline void setitem_ArrayInt(Array<int> *array, int index, int value)
 { (*array)[index] = value; }
 
+inline void setitem_ArrayDouble(Array<double> *array, int index, double value)
+{ (*array)[index] = value; }
+
+inline void setitem_ArrayRational(Array<Rational> *array, int index,
+				  const char *value)
+{ (*array)[index] = lexical_cast<Rational>(std::string(value)); }
+
 inline MixedStrategyProfile<double> *
 CopyElementStrategyDouble(const List<MixedStrategyProfile<double> > &p_list, int p_index)
 { return new MixedStrategyProfile<double>(p_list[p_index]); }
@@ -105,6 +112,24 @@ setitem_MixedStrategyProfileRationalStrategy(MixedStrategyProfile<Rational> *pro
 { (*profile)[index] = lexical_cast<Rational>(std::string(value)); }
 
 
+inline Array<double>
+setplayer_MixedStrategyProfileDouble(MixedStrategyProfile<double> *profile,
+				     int pl, Array<double> *probs)
+{
+  Vector<double> v(probs->Length());
+  for (int i = 1; i <= v.Length(); i++) v[i] = (*probs)[i];
+  return profile->SetPlayerStrategy(pl, v);
+}
+
+inline Array<Rational>
+setplayer_MixedStrategyProfileRational(MixedStrategyProfile<Rational> *profile,
+				       int pl, Array<Rational> *probs)
+{
+  Vector<Rational> v(probs->Length());
+  for (int i = 1; i <= v.Length(); i++) v[i] = (*probs)[i];
+  return profile->SetPlayerStrategy(pl, v);
+}
+
 inline void 
 setitem_MixedBehaviorProfileDouble(MixedBehaviorProfile<double> *profile,
            int index, double value)
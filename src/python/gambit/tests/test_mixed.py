@@ -86,7 +86,23 @@ class TestGambitMixedStrategyGame(object):
         assert self.profile_double[self.game.players[0]][1] == 0.72
         self.profile_rational[self.game.players[0]][1] = fractions.Fraction("2/9")
         assert self.profile_rational[self.game.players[0]][1] == fractions.Fraction("2/9")
-        
+
+    def test_set_player_strategy(self):
+        "Test setting one player's strategy at a time, as in best response dynamics"
+        game = gambit.Game.read_game("test_games/mixed_strategy.nfg")
+        for profile in [ game.mixed_strategy_profile(),
+                         game.mixed_strategy_profile(True) ]:
+            for step in xrange(3 * len(game.players)):
+                player = game.players[step % len(game.players)]
+                values = profile.strategy_values(player)
+                best = values.index(max(values))
+                probs = [ int(i == best) for i in xrange(len(values)) ]
+                payoffs = profile.set_player_strategy(player, probs)
+                assert profile[player] == probs
+                assert payoffs == [ profile.payoff(p) for p in game.players ]
+        assert_raises(ValueError, self.profile_double.set_player_strategy,
+                      0, [ 1.0 ])
+
     def test_liap_values(self):
         "Test retrieving Lyapunov values"
         assert self.profile_double.liap_value() == 0.0
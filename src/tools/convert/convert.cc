@@ -49,6 +49,8 @@ void PrintHelp(char *progname)
   std::cerr << "  -O FORMAT        output file format (required):\n";
   std::cerr << "     FORMAT=html   convert to HTML\n";
   std::cerr << "     FORMAT=sgame  convert to LaTeX sgame style\n";
+  std::cerr << "     FORMAT=binary convert to Gambit's binary game format\n";
+  std::cerr << "     FORMAT=native convert to .efg or .nfg format\n";
   std::cerr << "  -c PLAYER        the player to show on columns (default is 2)\n";
   std::cerr << "  -r PLAYER        the player to show on rows (default is 1)\n";
   std::cerr << "  -h               print this help message\n";
@@ -102,7 +104,8 @@ int main(int argc, char *argv[])
     std::cerr << argv[0] << ": Output format argument -O required.\n";
     return 1;
   }
-  else if (format != "sgame" && format != "html") {
+  else if (format != "sgame" && format != "html" &&
+	   format != "binary" && format != "native") {
     std::cerr << argv[0] << ": Unknown output format '" << format << "'.\n";
     return 1;
   }
@@ -115,7 +118,7 @@ int main(int argc, char *argv[])
   std::istream* input_stream = &std::cin;
   std::ifstream file_stream;
   if (optind < argc) {
-    file_stream.open(argv[optind]);
+    file_stream.open(argv[optind], std::ios::in | std::ios::binary);
     if (!file_stream.is_open()) {
       std::ostringstream error_message;
       error_message << argv[0] << ": " << argv[optind];
@@ -128,6 +131,11 @@ int main(int argc, char *argv[])
   try {
     Gambit::Game game = Gambit::ReadGame(*input_stream);
 
+    if (format == "binary" || format == "native") {
+      game->Write(std::cout, format);
+      return 0;
+    }
+
     if (rowPlayer < 1 || rowPlayer > game->NumPlayers()) {
       std::cerr << argv[0] << ": Player " << rowPlayer << " does not exist.\n";
       return 1;
@@ -373,6 +373,101 @@ void PrintSupport(std::ostream &p_stream,
 }
 #endif  // UNUSED
 
+//
+// Returns true if every information set with actions in the support may
+// be reached under the support
+//
+bool CanReachSupportedInfosets(const Gambit::BehaviorSupportProfile &p_support)
+{
+  Gambit::Game efg = p_support.GetGame();
+  for (int pl = 1; pl <= efg->NumPlayers(); pl++) {
+    Gambit::GamePlayer player = efg->GetPlayer(pl);
+    for (int iset = 1; iset <= player->NumInfosets(); iset++) {
+      if (p_support.NumActions(pl, iset) > 0 &&
+	  !p_support.MayReach(player->GetInfoset(iset))) {
+	return false;
+      }
+    }
+  }
+  return true;
+}
+
+//
+// Returns true if every play from the node, using the actions in the
+// support, passes through the information set
+//
+bool AlwaysReaches(const Gambit::BehaviorSupportProfile &p_support,
+		   const Gambit::GameNode &p_node,
+		   const Gambit::GameInfoset &p_infoset)
+{
+  if (p_node->NumChildren() == 0)  return false;
+  if (p_node->GetInfoset() == p_infoset)  return true;
+
+  Gambit::GameInfoset infoset = p_node->GetInfoset();
+  if (infoset->GetPlayer()->IsChance()) {
+    for (int i = 1; i <= p_node->NumChildren(); i++) {
+      if (!AlwaysReaches(p_support, p_node->GetChild(i), p_infoset)) {
+	return false;
+      }
+    }
+    return true;
+  }
+
+  if (p_support.NumActions(infoset) == 0)  return false;
+  for (int i = 1; i <= p_support.NumActions(infoset); i++) {
+    int act = p_support.GetAction(infoset, i)->GetNumber();
+    if (!AlwaysReaches(p_support, p_node->GetChild(act), p_infoset)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+//
+// Returns true if some action in the support is strictly dominated by
+// another in the support, conditional on reaching its information set,
+// where that information set is reached in every play under the support,
+// and every information set with actions in the support can still be
+// reached without the action.  A solution on the support which plays
+// such an action is not an equilibrium, and one which does not play it
+// is also a solution on the support without the action, which is found
+// when that support is solved.
+//
+// The information set must always be reached, since a solution on the
+// boundary of the support may not reach it, and may then play a dominated
+// action there; such solutions are reported, as they specify behavior
+// off the path of play.
+//
+bool HasDominatedAction(const Gambit::BehaviorSupportProfile &p_support)
+{
+  Gambit::Game efg = p_support.GetGame();
+  for (int pl = 1; pl <= efg->NumPlayers(); pl++) {
+    Gambit::GamePlayer player = efg->GetPlayer(pl);
+    for (int iset = 1; iset <= player->NumInfosets(); iset++) {
+      Gambit::GameInfoset infoset = player->GetInfoset(iset);
+      if (p_support.NumActions(pl, iset) < 2 ||
+	  !AlwaysReaches(p_support, efg->GetRoot(), infoset)) {
+	continue;
+      }
+      for (int act = 1; act <= p_support.NumActions(pl, iset); act++) {
+	Gambit::GameAction action = p_support.GetAction(pl, iset, act);
+	if (!p_support.IsDominated(action, true, true))  continue;
+
+	Gambit::BehaviorSupportProfile reduced(p_support);
+	reduced.RemoveAction(action);
+	if (CanReachSupportedInfosets(reduced))  return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool IsPossibleNashSupport(const Gambit::BehaviorSupportProfile &p_support)
+{
+  return (p_support.HasActiveActionsAtActiveInfosetsAndNoOthers() &&
+	  !HasDominatedAction(p_support));
+}
+
 void
 PossibleNashSubsupports(const Gambit::BehaviorSupportProfile &p_support,
 			const ActionCursorForSupport &p_cursor,
@@ -380,13 +475,13 @@ PossibleNashSubsupports(const Gambit::BehaviorSupportProfile &p_support,
 {
   ActionCursorForSupport copy(p_cursor);
   if (!copy.GoToNext()) {
-    if (p_support.HasActiveActionsAtActiveInfosetsAndNoOthers()) {
+    if (IsPossibleNashSupport(p_support)) {
       p_list.Append(p_support);
     }
 
     Gambit::BehaviorSupportProfile copySupport(p_support);
     copySupport.RemoveAction(p_cursor.GetAction());
-    if (copySupport.HasActiveActionsAtActiveInfosetsAndNoOthers()) {
+    if (IsPossibleNashSupport(copySupport)) {
       p_list.Append(copySupport);
     }
     return;
@@ -408,7 +503,8 @@ PossibleNashSubsupports(const Gambit::BehaviorSupportProfile &p_support,
 // was hacked to make this work, and recent refactorings have undone
 // the hacks it depended on.  So, for now, we do a really simple
 // implementation that works (but may be inefficient), and we will
-// go from there later.
+// go from there later.  Supports with a dominated action are dropped
+// here, before any system of equations is built for them.
 //
 Gambit::List<Gambit::BehaviorSupportProfile> 
 PossibleNashSubsupports(const Gambit::BehaviorSupportProfile &p_support)
@@ -22,7 +22,9 @@
 
 #include <iostream>
 #include <iomanip>
+#include <cmath>
 #include "libgambit/libgambit.h"
+#include "libgambit/parallel.h"
 
 using namespace Gambit;
 
@@ -36,6 +38,7 @@ using namespace Gambit;
 
 extern int g_numDecimals;
 extern bool g_verbose;
+extern int g_numThreads;
 
 //
 // A class to organize the data needed to build the polynomials
@@ -256,8 +259,14 @@ bool ExtendsToNash(const MixedBehaviorProfile<double> &bs)
 }
 
 
+//
+// Finds the equilibria with the support given.  The caller holds
+// p_gameLock, which guards the objects of the game; it is released while
+// the roots of the system are found, as that does not use the game.
+//
 List<MixedBehaviorProfile<double> > 
-SolveSupport(const BehaviorSupportProfile &p_support, bool &p_isSingular)
+SolveSupport(const BehaviorSupportProfile &p_support, bool &p_isSingular,
+	     Mutex &p_gameLock)
 {
   ProblemData data(p_support);
   gPolyList<double> equations = NashOnSupportEquationsAndInequalities(data);
@@ -268,35 +277,39 @@ SolveSupport(const BehaviorSupportProfile &p_support, bool &p_isSingular)
   tops = (double) 1;
   gRectangle<double> Cube(bottoms, tops); 
 
-  QuikSolv<double> quickie(equations);
+  List<Vector<double> > solutionlist;
+  {
+    MutexUnlock unlock(p_gameLock);
+    QuikSolv<double> quickie(equations);
 #ifdef UNUSED
-  if(params.trace>0) {
-    (*params.tracefile) << "\nThe equilibrium equations are \n" 
-      << quickie.UnderlyingEquations() ;
-  }  
+    if(params.trace>0) {
+      (*params.tracefile) << "\nThe equilibrium equations are \n" 
+	<< quickie.UnderlyingEquations() ;
+    }  
 #endif  // UNUSED
 
-  // 2147483647 = 2^31-1 = MaxInt
+    // 2147483647 = 2^31-1 = MaxInt
 
-  try {
-    if(quickie.FindCertainNumberOfRoots(Cube,2147483647,0)) {
+    try {
+      if(quickie.FindCertainNumberOfRoots(Cube,2147483647,0)) {
 #ifdef UNUSED
-      if(params.trace>0) {
-	(*params.tracefile) << "\nThe system has the following roots in [0,1]^"
-			    << num_vars << " :\n" << quickie.RootList();
-      }
+	if(params.trace>0) {
+	  (*params.tracefile) << "\nThe system has the following roots in [0,1]^"
+			      << num_vars << " :\n" << quickie.RootList();
+	}
 #endif  // UNUSED
+      }
+    }
+    catch (const Gambit::SingularMatrixException &) {
+      p_isSingular = true;
+    }
+    catch (const Gambit::AssertionException &e) {
+      std::cerr << "Assertion warning: " << e.what() << std::endl;
+      p_isSingular = true;
     }
-  }
-  catch (const Gambit::SingularMatrixException &) {
-    p_isSingular = true;
-  }
-  catch (const Gambit::AssertionException &e) {
-    std::cerr << "Assertion warning: " << e.what() << std::endl;
-    p_isSingular = true;
-  }
   
-  List<Vector<double> > solutionlist = quickie.RootList();
+    solutionlist = quickie.RootList();
+  }
 
   List<MixedBehaviorProfile<double> > solutions;
   for (int k = 1; k <= solutionlist.Length(); k++) {
@@ -360,6 +373,25 @@ MixedBehaviorProfile<double> ToFullSupport(const MixedBehaviorProfile<double> &p
   return fullProfile;
 }
 
+//
+// Returns true if the profile agrees, to within the tolerance used in
+// checking equilibria, with one in the list.  The same equilibrium may
+// be found on more than one support, when some action in a support is
+// played with probability zero.
+//
+bool IsDuplicate(const MixedBehaviorProfile<double> &p_profile,
+		 const List<MixedBehaviorProfile<double> > &p_list)
+{
+  for (int i = 1; i <= p_list.Length(); i++) {
+    bool same = true;
+    for (int j = 1; same && j <= p_profile.Length(); j++) {
+      same = (std::abs(p_profile[j] - p_list[i][j]) < 1.0e-6);
+    }
+    if (same)  return true;
+  }
+  return false;
+}
+
 void PrintSupport(std::ostream &p_stream,
 		  const std::string &p_label, const BehaviorSupportProfile &p_support)
 {
@@ -386,29 +418,72 @@ void PrintSupport(std::ostream &p_stream,
   p_stream << std::endl;
 }
 
-void SolveExtensive(const Game &p_game)
-{
-  List<BehaviorSupportProfile> supports = PossibleNashSubsupports(p_game);
+//
+// Solves for the equilibria on each of a list of supports, one piece per
+// support.  The objects of the game are not safe to share between
+// threads, so all steps other than finding the roots of the systems of
+// equations are done holding a lock.  Equilibria are printed in the order
+// of the supports, omitting those already printed for an earlier support.
+//
+class BehaviorSupportTask : public ParallelTask {
+private:
+  const List<BehaviorSupportProfile> &m_supports;
+  Array<List<MixedBehaviorProfile<double> > > m_solutions;
+  Array<bool> m_singular;
+  List<MixedBehaviorProfile<double> > m_printed;
+  Mutex m_gameLock;
 
-  for (int i = 1; i <= supports.Length(); i++) {
-    if (g_verbose) {
-      PrintSupport(std::cout, "candidate", supports[i]);
-    }
-      
-    bool isSingular = false;
-    List<MixedBehaviorProfile<double> > newsolns = 
-      SolveSupport(supports[i], isSingular);
-
-    for (int j = 1; j <= newsolns.Length(); j++) {
-      MixedBehaviorProfile<double> fullProfile = ToFullSupport(newsolns[j]);
-      if (fullProfile.GetLiapValue(true) < 1.0e-6) {
-	PrintProfile(std::cout, "NE", fullProfile);
-      }
+public:
+  BehaviorSupportTask(const List<BehaviorSupportProfile> &p_supports)
+    : m_supports(p_supports), m_solutions(p_supports.Length()),
+      m_singular(p_supports.Length()) { }
+
+  void Run(int p_piece);
+  bool Finish(int p_piece);
+};
+
+void BehaviorSupportTask::Run(int p_piece)
+{
+  MutexLock lock(m_gameLock);
+  bool isSingular = false;
+  List<MixedBehaviorProfile<double> > newsolns = 
+    SolveSupport(m_supports[p_piece+1], isSingular, m_gameLock);
+
+  for (int j = 1; j <= newsolns.Length(); j++) {
+    MixedBehaviorProfile<double> fullProfile = ToFullSupport(newsolns[j]);
+    if (fullProfile.GetLiapValue(true) < 1.0e-6) {
+      m_solutions[p_piece+1].Append(fullProfile);
     }
-      
-    if (isSingular && g_verbose) {
-      PrintSupport(std::cout, "singular", supports[i]);
+  }
+  m_singular[p_piece+1] = isSingular;
+}
+
+bool BehaviorSupportTask::Finish(int p_piece)
+{
+  MutexLock lock(m_gameLock);
+  if (g_verbose) {
+    PrintSupport(std::cout, "candidate", m_supports[p_piece+1]);
+  }
+
+  const List<MixedBehaviorProfile<double> > &solutions = 
+    m_solutions[p_piece+1];
+  for (int j = 1; j <= solutions.Length(); j++) {
+    if (!IsDuplicate(solutions[j], m_printed)) {
+      PrintProfile(std::cout, "NE", solutions[j]);
+      m_printed.Append(solutions[j]);
     }
   }
+  m_solutions[p_piece+1] = List<MixedBehaviorProfile<double> >();
+
+  if (m_singular[p_piece+1] && g_verbose) {
+    PrintSupport(std::cout, "singular", m_supports[p_piece+1]);
+  }
+  return true;
 }
 
+void SolveExtensive(const Game &p_game)
+{
+  List<BehaviorSupportProfile> supports = PossibleNashSubsupports(p_game);
+  BehaviorSupportTask task(supports);
+  RunParallel(task, supports.Length(), g_numThreads);
+}
@@ -31,6 +31,7 @@
 
 int g_numDecimals = 6;
 bool g_verbose = false;
+int g_numThreads = 0;
 
 void PrintBanner(std::ostream &p_stream)
 {
@@ -53,6 +54,8 @@ void PrintHelp(char *progname)
   std::cerr << "  -S               use strategic game\n";
   std::cerr << "  -H               use heuristic search method to optimize time\n";
   std::cerr << "                   to find first equilibrium (strategic games only)\n";
+  std::cerr << "  -j THREADS       number of threads to use (default is the\n";
+  std::cerr << "                   number of processors; not used with -H)\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -V, --verbose    verbose mode (shows supports investigated)\n";
   std::cerr << "  -v, --version    print version information\n";
@@ -78,7 +81,7 @@ int main(int argc, char *argv[])
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "d:hHSqvV", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:hHSj:qvV", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -94,6 +97,9 @@ int main(int argc, char *argv[])
     case 'S':
       useStrategic = true;
       break;
+    case 'j':
+      g_numThreads = atoi(optarg);
+      break;
     case 'q':
       quiet = true;
       break;
@@ -77,7 +77,7 @@ public:
 
    inline gTreeNode<gPoly<T> >* RootNode()                     const 
      { return PartialTree.RootNode(); }
-   inline gPoly<T> RootPoly()                                  const 
+   inline const gPoly<T> &RootPoly()                          const 
      { return RootNode()->GetData(); }
    T ValueOfRootPoly(const Gambit::Vector<T>& point)           const;
    T ValueOfPartialOfRootPoly(const int&, const Gambit::Vector<T>&)   const;
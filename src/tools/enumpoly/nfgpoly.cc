@@ -23,7 +23,9 @@
 
 #include <iostream>
 #include <iomanip>
+#include <cmath>
 
+#include "libgambit/parallel.h"
 #include "nfgensup.h"
 #include "gpoly.h"
 #include "gpolylst.h"
@@ -32,6 +34,7 @@
 
 extern int g_numDecimals;
 extern bool g_verbose; 
+extern int g_numThreads;
 
 class PolEnumModule  {
 private:
@@ -65,7 +68,9 @@ private:
 public:
   PolEnumModule(const Gambit::StrategySupportProfile &);
   
-  int PolEnum(void);
+  /// The caller holds the lock guarding the objects of the game, which
+  /// is released while the roots of the system are found
+  int PolEnum(Gambit::Mutex &p_gameLock);
   
   long NumEvals(void) const;
   double Time(void) const;
@@ -94,7 +99,7 @@ PolEnumModule::PolEnumModule(const Gambit::StrategySupportProfile &S)
 }
 
 
-int PolEnumModule::PolEnum(void)
+int PolEnumModule::PolEnum(Gambit::Mutex &p_gameLock)
 {
   gPolyList<double> equations = NashOnSupportEquationsAndInequalities();
 
@@ -117,8 +122,11 @@ int PolEnumModule::PolEnum(void)
   gRectangle<double> Cube(bottoms, tops); 
 
   // start QuikSolv
-  Gambit::List<Gambit::Vector<double> > solutionlist = NashOnSupportSolnVectors(equations,
-								   Cube);
+  Gambit::List<Gambit::Vector<double> > solutionlist;
+  {
+    Gambit::MutexUnlock unlock(p_gameLock);
+    solutionlist = NashOnSupportSolnVectors(equations, Cube);
+  }
 
   int index = SaveSolutions(solutionlist);
   return index;	 
@@ -291,10 +299,11 @@ bool PolEnumModule::IsSingular() const
 
 int PolEnum(const Gambit::StrategySupportProfile &support,
 	    Gambit::List<Gambit::MixedStrategyProfile<double> > &solutions, 
-	    long &nevals, double &time, bool &is_singular)
+	    long &nevals, double &time, bool &is_singular,
+	    Gambit::Mutex &p_gameLock)
 {
   PolEnumModule module(support);
-  module.PolEnum();
+  module.PolEnum(p_gameLock);
   nevals = module.NumEvals();
   time = module.Time();
   solutions = module.GetSolutions();
@@ -457,6 +466,25 @@ Gambit::MixedStrategyProfile<double> ToFullSupport(const Gambit::MixedStrategyPr
   return fullProfile;
 }
 
+//
+// Returns true if the profile agrees, to within the tolerance used in
+// checking equilibria, with one in the list.  The same equilibrium may
+// be found on more than one support, when some strategy in a support is
+// played with probability zero.
+//
+bool IsDuplicate(const Gambit::MixedStrategyProfile<double> &p_profile,
+		 const Gambit::List<Gambit::MixedStrategyProfile<double> > &p_list)
+{
+  for (int i = 1; i <= p_list.Length(); i++) {
+    bool same = true;
+    for (int j = 1; same && j <= p_profile.MixedProfileLength(); j++) {
+      same = (std::abs(p_profile[j] - p_list[i][j]) < 1.0e-6);
+    }
+    if (same)  return true;
+  }
+  return false;
+}
+
 void PrintSupport(std::ostream &p_stream, 
 		  const std::string &p_label, const Gambit::StrategySupportProfile &p_support)
 {
@@ -478,37 +506,76 @@ void PrintSupport(std::ostream &p_stream,
   p_stream << std::endl;
 }
 
-void SolveStrategic(const Gambit::Game &p_nfg)
-{
-  Gambit::List<Gambit::StrategySupportProfile> supports = PossibleNashSubsupports(p_nfg);
+//
+// Solves for the equilibria on each of a list of supports, one piece per
+// support.  The objects of the game are not safe to share between
+// threads, so all steps other than finding the roots of the systems of
+// equations are done holding a lock.  Equilibria are printed in the order
+// of the supports, omitting those already printed for an earlier support.
+//
+class StrategySupportTask : public Gambit::ParallelTask {
+private:
+  const Gambit::List<Gambit::StrategySupportProfile> &m_supports;
+  Gambit::Array<Gambit::List<Gambit::MixedStrategyProfile<double> > > m_solutions;
+  Gambit::Array<bool> m_singular;
+  Gambit::List<Gambit::MixedStrategyProfile<double> > m_printed;
+  Gambit::Mutex m_gameLock;
 
-  for (int i = 1; i <= supports.Length(); i++) {
-    long newevals = 0;
-    double newtime = 0.0;
-    Gambit::List<Gambit::MixedStrategyProfile<double> > newsolns;
-    bool is_singular = false;
-    
-    if (g_verbose) {
-      PrintSupport(std::cout, "candidate", supports[i]);
-    }
+public:
+  StrategySupportTask(const Gambit::List<Gambit::StrategySupportProfile> &p_supports)
+    : m_supports(p_supports), m_solutions(p_supports.Length()),
+      m_singular(p_supports.Length()) { }
 
-    PolEnum(supports[i], newsolns, newevals, newtime, is_singular);
-      
-    for (int j = 1; j <= newsolns.Length(); j++) {
-      Gambit::MixedStrategyProfile<double> fullProfile = ToFullSupport(newsolns[j]);
-      if (fullProfile.GetLiapValue() < 1.0e-6) {
-	PrintProfile(std::cout, "NE", fullProfile);
-      }
-    }
+  void Run(int p_piece);
+  bool Finish(int p_piece);
+};
 
-    if (is_singular && g_verbose) {
-      PrintSupport(std::cout, "singular", supports[i]);
+void StrategySupportTask::Run(int p_piece)
+{
+  Gambit::MutexLock lock(m_gameLock);
+  long newevals = 0;
+  double newtime = 0.0;
+  Gambit::List<Gambit::MixedStrategyProfile<double> > newsolns;
+  bool is_singular = false;
+
+  PolEnum(m_supports[p_piece+1], newsolns, newevals, newtime, is_singular,
+	  m_gameLock);
+      
+  for (int j = 1; j <= newsolns.Length(); j++) {
+    Gambit::MixedStrategyProfile<double> fullProfile = ToFullSupport(newsolns[j]);
+    if (fullProfile.GetLiapValue() < 1.0e-6) {
+      m_solutions[p_piece+1].Append(fullProfile);
     }
   }
+  m_singular[p_piece+1] = is_singular;
 }
 
+bool StrategySupportTask::Finish(int p_piece)
+{
+  Gambit::MutexLock lock(m_gameLock);
+  if (g_verbose) {
+    PrintSupport(std::cout, "candidate", m_supports[p_piece+1]);
+  }
 
+  const Gambit::List<Gambit::MixedStrategyProfile<double> > &solutions =
+    m_solutions[p_piece+1];
+  for (int j = 1; j <= solutions.Length(); j++) {
+    if (!IsDuplicate(solutions[j], m_printed)) {
+      PrintProfile(std::cout, "NE", solutions[j]);
+      m_printed.Append(solutions[j]);
+    }
+  }
+  m_solutions[p_piece+1] = Gambit::List<Gambit::MixedStrategyProfile<double> >();
 
+  if (m_singular[p_piece+1] && g_verbose) {
+    PrintSupport(std::cout, "singular", m_supports[p_piece+1]);
+  }
+  return true;
+}
 
-
-
+void SolveStrategic(const Gambit::Game &p_nfg)
+{
+  Gambit::List<Gambit::StrategySupportProfile> supports = PossibleNashSubsupports(p_nfg);
+  StrategySupportTask task(supports);
+  Gambit::RunParallel(task, supports.Length(), g_numThreads);
+}
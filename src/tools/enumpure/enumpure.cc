@@ -47,6 +47,10 @@ void PrintHelp(char *progname)
   std::cerr << "  -S               report equilibria in strategies even for extensive games\n";
   std::cerr << "  -A               compute agent form equilibria\n";
   std::cerr << "  -P               find only subgame-perfect equilibria\n";
+  std::cerr << "  -j THREADS       number of threads to use (default is the\n";
+  std::cerr << "                   number of processors)\n";
+  std::cerr << "  -B               print equilibria in a binary format, for use\n";
+  std::cerr << "                   by other programs\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -v, --version    print version information\n";
@@ -58,7 +62,8 @@ int main(int argc, char *argv[])
 {
   opterr = 0;
   bool quiet = false, reportStrategic = false, solveAgent = false, bySubgames = false;
-  bool printDetail = false;
+  bool printDetail = false, printBinary = false;
+  int threads = 0;
   
   int long_opt_index = 0;
   struct option long_options[] = {
@@ -67,7 +72,7 @@ int main(int argc, char *argv[])
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "DvhqASP", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "DvhqASPj:B", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -83,9 +88,15 @@ int main(int argc, char *argv[])
     case 'P':
       bySubgames = true;
       break;
+    case 'j':
+      threads = atoi(optarg);
+      break;
     case 'h':
       PrintHelp(argv[0]);
       break;
+    case 'B':
+      printBinary = true;
+      break;
     case 'q':
       quiet = true;
       break;
@@ -123,7 +134,10 @@ int main(int argc, char *argv[])
     Game game = ReadGame(*input_stream);
     shared_ptr<StrategyProfileRenderer<Rational> > renderer;
     if (reportStrategic || !game->IsTree()) {
-      if (printDetail) {
+      if (printBinary) {
+	renderer = new MixedStrategyBinaryRenderer<Rational>(std::cout);
+      }
+      else if (printDetail) {
 	renderer = new MixedStrategyDetailRenderer<Rational>(std::cout);
       }
       else {
@@ -131,7 +145,10 @@ int main(int argc, char *argv[])
       }
     }
     else {
-      if (printDetail) {
+      if (printBinary) {
+	renderer = new BehavStrategyBinaryRenderer<Rational>(std::cout);
+      }
+      else if (printDetail) {
 	renderer = new BehavStrategyDetailRenderer<Rational>(std::cout);
       }
       else {
@@ -147,25 +164,29 @@ int main(int argc, char *argv[])
 	}
 	else {
 	  shared_ptr<NashStrategySolver<Rational> > substage = 
-	    new NashEnumPureStrategySolver();
+	    new NashEnumPureStrategySolver(0, threads);
 	  stage = new NashBehavViaStrategySolver<Rational>(substage);
 	}
 	SubgameNashBehavSolver<Rational> algorithm(stage, renderer);
+	algorithm.SetStreaming(true);
 	algorithm.Solve(game);
       }
       else {
 	if (solveAgent) {
 	  NashEnumPureAgentSolver algorithm(renderer);
+	  algorithm.SetStreaming(true);
 	  algorithm.Solve(game);
 	}
 	else {
-	  NashEnumPureStrategySolver algorithm(renderer);
+	  NashEnumPureStrategySolver algorithm(renderer, threads);
+	  algorithm.SetStreaming(true);
 	  algorithm.Solve(game);
 	}
       }
     }
     else {
-      NashEnumPureStrategySolver algorithm(renderer);
+      NashEnumPureStrategySolver algorithm(renderer, threads);
+      algorithm.SetStreaming(true);
       algorithm.Solve(game);
     }
     return 0;
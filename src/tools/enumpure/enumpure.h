@@ -23,18 +23,202 @@
 #ifndef ENUMPURE_H
 #define ENUMPURE_H
 
+#include <cmath>
+#include <vector>
 #include "libgambit/libgambit.h"
 #include "libgambit/nash.h"
+#include "libgambit/parallel.h"
+#include "libgambit/gametable.h"
 
 using namespace Gambit;
 
+///
+/// Screens the contingencies of a strategic game for pure strategy
+/// equilibria, one block of contingencies at a time.  A contingency
+/// passes the screen if each player's payoff is at least the largest
+/// payoff the player can attain by deviating, which is precomputed for
+/// every contingency of the other players by maximizing along the
+/// player's axis of the payoff table.  The screen uses floating-point
+/// payoffs with a tolerance well above any conversion error, so it never
+/// rejects an equilibrium; contingencies which pass are verified exactly
+/// as each block is finished, which happens in the order of the blocks.
+/// Equilibria are rendered as they are verified, and also appended to the
+/// list of solutions unless the solver is streaming.
+///
+class PureNashScreen : public ParallelTask {
+public:
+  /// The number of contingencies in each block
+  static const long BLOCK_SIZE = 65536L;
+
+  PureNashScreen(const Game &p_game,
+		 shared_ptr<StrategyProfileRenderer<Rational> > p_onEquilibrium,
+		 List<MixedStrategyProfile<Rational> > &p_solutions,
+		 bool p_streaming = false);
+  virtual ~PureNashScreen() { }
+
+  /// The number of blocks of contingencies
+  int NumBlocks(void) const 
+  { return (int) ((m_size + BLOCK_SIZE - 1) / BLOCK_SIZE); }
+  /// Computes the maxima along the players' axes, in parallel
+  void ComputeMaxima(int p_threads);
+
+  virtual void Run(int p_block);
+  virtual bool Finish(int p_block);
+
+private:
+  Game m_game;
+  shared_ptr<StrategyProfileRenderer<Rational> > m_onEquilibrium;
+  List<MixedStrategyProfile<Rational> > &m_solutions;
+  bool m_streaming;
+  int m_numPlayers;
+  long m_size;
+  /// For each player, the payoff table, the extent and stride of the
+  /// player's axis, and the best payoff along the axis
+  std::vector<const double *> m_payoffs;
+  std::vector<int> m_dims;
+  std::vector<long> m_strides;
+  std::vector<std::vector<double> > m_maxima;
+  /// The contingencies in each block which pass the screen
+  std::vector<std::vector<long> > m_candidates;
+
+  /// Computes the maxima for the player over a range of contingencies
+  /// of the other players
+  void MaximizeAlongAxis(int pl, long p_first, long p_last);
+
+  class MaximaTask;
+  friend class MaximaTask;
+  class MaximaTask : public ParallelTask {
+  private:
+    PureNashScreen &m_screen;
+  public:
+    MaximaTask(PureNashScreen &p_screen) : m_screen(p_screen) { }
+    virtual ~MaximaTask() { }
+    virtual void Run(int p_piece);
+  };
+};
+
+inline
+PureNashScreen::PureNashScreen(const Game &p_game,
+			       shared_ptr<StrategyProfileRenderer<Rational> > p_onEquilibrium,
+			       List<MixedStrategyProfile<Rational> > &p_solutions,
+			       bool p_streaming)
+  : m_game(p_game), m_onEquilibrium(p_onEquilibrium), 
+    m_solutions(p_solutions), m_streaming(p_streaming),
+    m_numPlayers(p_game->NumPlayers()), m_size(1L),
+    m_payoffs(m_numPlayers), m_dims(m_numPlayers), m_strides(m_numPlayers),
+    m_maxima(m_numPlayers)
+{
+  // The payoff tables are built on first use, so this must happen
+  // before any other thread looks at them
+  const GameTableRep &table = dynamic_cast<const GameTableRep &>(*p_game);
+  for (int pl = 1; pl <= m_numPlayers; pl++) {
+    m_payoffs[pl-1] = table.GetPayoffTable<double>(pl);
+    m_dims[pl-1] = table.GetTableDim(pl);
+    m_strides[pl-1] = m_size;
+    m_size *= m_dims[pl-1];
+  }
+  m_candidates.resize(NumBlocks());
+}
+
+inline void PureNashScreen::MaximizeAlongAxis(int pl, long p_first, long p_last)
+{
+  const double *payoffs = m_payoffs[pl-1];
+  std::vector<double> &maxima = m_maxima[pl-1];
+  long inner = m_strides[pl-1], outer = inner * m_dims[pl-1];
+
+  // Entry m of the maxima collects the contingencies with outer index
+  // m / inner and inner index m % inner, along the player's axis
+  for (long m = p_first; m < p_last; ) {
+    long o = m / inner, k = m % inner;
+    long count = std::min(inner - k, p_last - m);
+    const double *row = payoffs + o * outer + k;
+    double *max = &maxima[m];
+    std::copy(row, row + count, max);
+    for (int j = 1; j < m_dims[pl-1]; j++) {
+      row += inner;
+      for (long i = 0; i < count; i++) {
+	if (row[i] > max[i])  max[i] = row[i];
+      }
+    }
+    m += count;
+  }
+}
+
+inline void PureNashScreen::MaximaTask::Run(int p_piece)
+{
+  long first = (long) p_piece * BLOCK_SIZE;
+  for (int pl = 1; pl <= m_screen.m_numPlayers; pl++) {
+    long size = m_screen.m_size / m_screen.m_dims[pl-1];
+    if (first < size) {
+      m_screen.MaximizeAlongAxis(pl, first, std::min(first + BLOCK_SIZE, size));
+    }
+  }
+}
+
+inline void PureNashScreen::ComputeMaxima(int p_threads)
+{
+  int pieces = 0;
+  for (int pl = 1; pl <= m_numPlayers; pl++) {
+    long size = m_size / m_dims[pl-1];
+    m_maxima[pl-1].resize(size);
+    pieces = std::max(pieces, (int) ((size + BLOCK_SIZE - 1) / BLOCK_SIZE));
+  }
+  MaximaTask task(*this);
+  RunParallel(task, pieces, p_threads);
+}
+
+inline void PureNashScreen::Run(int p_block)
+{
+  long first = (long) p_block * BLOCK_SIZE;
+  long last = std::min(first + BLOCK_SIZE, m_size);
+  std::vector<long> &candidates = m_candidates[p_block];
+  for (long c = first; c < last; c++) {
+    int pl = 1;
+    for (; pl <= m_numPlayers; pl++) {
+      long inner = m_strides[pl-1], outer = inner * m_dims[pl-1];
+      double max = m_maxima[pl-1][(c / outer) * inner + c % inner];
+      if (m_payoffs[pl-1][c] < max - 1.0e-9 * (std::fabs(max) + 1.0)) {
+	break;
+      }
+    }
+    if (pl > m_numPlayers) {
+      candidates.push_back(c);
+    }
+  }
+}
+
+inline bool PureNashScreen::Finish(int p_block)
+{
+  const std::vector<long> &candidates = m_candidates[p_block];
+  for (size_t i = 0; i < candidates.size(); i++) {
+    PureStrategyProfile profile = m_game->NewPureStrategyProfile();
+    for (int pl = 1; pl <= m_numPlayers; pl++) {
+      int st = (int) ((candidates[i] / m_strides[pl-1]) % m_dims[pl-1]) + 1;
+      profile->SetStrategy(m_game->GetPlayer(pl)->GetStrategy(st));
+    }
+    if (profile->IsNash()) {
+      MixedStrategyProfile<Rational> mixed = profile->ToMixedStrategyProfile();
+      m_onEquilibrium->Render(mixed);
+      if (!m_streaming) {
+	m_solutions.Append(mixed);
+      }
+    }
+  }
+  std::vector<long>().swap(m_candidates[p_block]);
+  return true;
+}
+
 class NashEnumPureStrategySolver : public NashStrategySolver<Rational> {
 public:
-   NashEnumPureStrategySolver(Gambit::shared_ptr<StrategyProfileRenderer<Rational> > p_onEquilibrium = 0) 
-    : NashStrategySolver<Rational>(p_onEquilibrium) { }
+  NashEnumPureStrategySolver(Gambit::shared_ptr<StrategyProfileRenderer<Rational> > p_onEquilibrium = 0,
+			     int p_threads = 0) 
+    : NashStrategySolver<Rational>(p_onEquilibrium), m_threads(p_threads) { }
   virtual ~NashEnumPureStrategySolver()  { }
 
   List<MixedStrategyProfile<Rational> > Solve(const Game &p_game) const;
+
+private:
+  int m_threads;
 };
 
 inline List<MixedStrategyProfile<Rational> >
@@ -44,11 +228,20 @@ NashEnumPureStrategySolver::Solve(const Game &p_game) const
     throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
   }
   List<MixedStrategyProfile<Rational> > solutions;
+  if (dynamic_cast<GameTableRep *>(p_game.operator->())) {
+    PureNashScreen screen(p_game, m_onEquilibrium, solutions, m_streaming);
+    screen.ComputeMaxima(m_threads);
+    RunParallel(screen, screen.NumBlocks(), m_threads);
+    return solutions;
+  }
+
   for (StrategyProfileIterator citer(p_game); !citer.AtEnd(); citer++) {
     if ((*citer)->IsNash()) {
       MixedStrategyProfile<Rational> profile = (*citer)->ToMixedStrategyProfile();
       m_onEquilibrium->Render(profile);
-      solutions.Append(profile);
+      if (!m_streaming) {
+	solutions.Append(profile);
+      }
     }
   }
   return solutions;
@@ -72,7 +265,9 @@ NashEnumPureAgentSolver::Solve(const BehaviorSupportProfile &p_support) const
     if (citer->IsAgentNash()) {
       MixedBehaviorProfile<Rational> profile = citer->ToMixedBehaviorProfile();
       m_onEquilibrium->Render(profile);
-      solutions.Append(profile);
+      if (!m_streaming) {
+	solutions.Append(profile);
+      }
     }
   }
   return solutions;
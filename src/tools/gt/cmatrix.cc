@@ -28,7 +28,6 @@ cvector::~cvector() { delete []x; }
 cmatrix::~cmatrix()
  { delete []x; }
 
-int cvector::num_vec_cons = 0;
 cmatrix cmatrix::inv(bool &worked) const {
 	if (m!=n) {
 		cerr << "invalid cmatrix inverse" << endl;
@@ -43,7 +43,8 @@ void PrintProfile(std::ostream &p_stream,
 // This executes the GNM algorithm on game A.
 // Interpretation of parameters:
 // g: perturbation ray.
-// Eq: an array of equilibria will be stored here
+// Eq: an array of equilibria will be stored here; they are not printed,
+//     so that the caller can report them as it sees fit
 // steps: number of steps to take within a support cell; higher 
 //        values of this parameter slow GNM down, but may help it
 //        avoid getting off the path.
@@ -317,8 +318,6 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
 	    Eq = (cvector **)realloc(Eq, (numEq+2)*sizeof(cvector *));	
 	    Eq[numEq] = new cvector(M);
 	    *(Eq[numEq++]) = sigma;
-
-	    PrintProfile(std::cout, "NE", sigma);
       }
 	  Index = -Index;
 	  s_hat_old = -1;
@@ -39,6 +39,11 @@ class gnmgame {
   
   
   
+  // Returns a new game with the same payoffs, which can be used by
+  // another thread at the same time as this one, or NULL if the game
+  // does not support this.
+  virtual gnmgame *makeWorkspace() { return NULL; }
+
   // Input: s[i] has integer index of player i's pure strategy
   // s is of length numPlayers
   virtual double getPurePayoff(int player, int *s) = 0; 
@@ -17,20 +17,46 @@
  * Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
-#include <vector>
 #include "cmatrix.h"
 #include "nfgame.h"
 
-nfgame::nfgame(int numPlayers, int *actions, const cvector &payoffs) : gnmgame(numPlayers, actions), payoffs(payoffs) {
+nfgame::nfgame(int numPlayers, int *actions, const cvector &payoffs) : gnmgame(numPlayers, actions), ownPayoffs(new cvector(payoffs)) {
+  this->payoffs = ownPayoffs->values();
+  init();
+}
+
+nfgame::nfgame(int numPlayers, int *actions, const double *payoffs) : gnmgame(numPlayers, actions), payoffs(payoffs), ownPayoffs(NULL) {
+  init();
+}
+
+nfgame::nfgame(const nfgame &g) : gnmgame(g.numPlayers, g.actions), payoffs(g.payoffs), ownPayoffs(NULL) {
+  init();
+}
+
+void nfgame::init() {
   blockSize = new int[numPlayers + 1];
   blockSize[0] = 1;
   for(int i = 1; i <= numPlayers; i++) {
     blockSize[i] = blockSize[i-1]*actions[i-1];
   }
+  work = new double[blockSize[numPlayers]];
+  local = new double[maxActions*maxActions];
 }
 
 nfgame::~nfgame() {
+  delete[] local;
+  delete[] work;
   delete[] blockSize;
+  delete ownPayoffs;
+}
+
+void nfgame::copyPayoffs() {
+  ownPayoffs = new cvector(const_cast<double *>(payoffs), numPlayers * blockSize[numPlayers]);
+  payoffs = ownPayoffs->values();
+}
+
+gnmgame *nfgame::makeWorkspace() {
+  return new nfgame(*this);
 }
 
 int nfgame::findIndex(int player, int *s) {
@@ -41,125 +67,115 @@ int nfgame::findIndex(int player, int *s) {
 }
 
 double nfgame::getMixedPayoff(int player, cvector &s) {
-  double *m = new double[blockSize[numPlayers]];
-  try {
-    memcpy(m, payoffs.values() + player * blockSize[numPlayers], blockSize[numPlayers]*sizeof(double));
-    double p = localPayoff(s, m, numPlayers-1);
-    delete [] m;
-    return p;
-  }
-  catch (...) {
-    delete [] m;
-    throw;
-  }
+  return localPayoff(s, payoffs + player * blockSize[numPlayers], work, numPlayers-1);
 }
 
 void nfgame::getPayoffVector(cvector &dest, int player, const cvector &s){
-  vector<double> t(payoffs.values()+player*blockSize[numPlayers], payoffs.values()+(player+1)*blockSize[numPlayers]);
-
-  localPayoffVector(dest.values(), player,const_cast<cvector&>(s),&(t[0]),numPlayers-1);
+  localPayoffVector(dest.values(), player, const_cast<cvector&>(s), 
+		    payoffs + player * blockSize[numPlayers], work, numPlayers-1);
 }
 
 void nfgame::payoffMatrix(cmatrix &dest, cvector &s, double fuzz) {
   int rown, coln, rowi, coli;
   double fuzzcount;
-  double *m = new double[blockSize[numPlayers]];
-  double *local = new double[maxActions*maxActions];
-  try {
-    for(rown = 0; rown < numPlayers; rown++) {
-      for(coln = 0; coln < numPlayers; coln++) {
-        if(rown == coln) {
-	  fuzzcount = fuzz;
-	  for(rowi=firstAction(rown); rowi < lastAction(rown); rowi++) {
-	    for(coli=firstAction(coln); coli < lastAction(coln); coli++) {
-	      dest[rowi][coli]=fuzzcount;
-	      fuzzcount += fuzz;
-	    }
+  for(rown = 0; rown < numPlayers; rown++) {
+    for(coln = 0; coln < numPlayers; coln++) {
+      if(rown == coln) {
+	fuzzcount = fuzz;
+	for(rowi=firstAction(rown); rowi < lastAction(rown); rowi++) {
+	  for(coli=firstAction(coln); coli < lastAction(coln); coli++) {
+	    dest[rowi][coli]=fuzzcount;
+	    fuzzcount += fuzz;
 	  }
-        } else {
-	  // set m to be the payoffs for player rown
-	  memcpy(m, payoffs.values() + rown * blockSize[numPlayers], blockSize[numPlayers] * sizeof(double));
-	  localPayoffMatrix(local, rown, coln, s, m, numPlayers-1);
-	  for(rowi = firstAction(rown); rowi < lastAction(rown); rowi++) {
-	    for(coli = firstAction(coln); coli < lastAction(coln); coli++) {
-	      if(rown > coln) {
-	        dest[rowi][coli] = *(local + (rowi - firstAction(rown))*actions[coln] + (coli - firstAction(coln)));
-	      } else {
-	        dest[rowi][coli] = *(local + (coli - firstAction(coln))*actions[rown] + (rowi - firstAction(rown)));
-	      }
+	}
+      } else {
+	// contract the payoffs for player rown
+	localPayoffMatrix(local, rown, coln, s, payoffs + rown * blockSize[numPlayers], work, numPlayers-1);
+	for(rowi = firstAction(rown); rowi < lastAction(rown); rowi++) {
+	  for(coli = firstAction(coln); coli < lastAction(coln); coli++) {
+	    if(rown > coln) {
+	      dest[rowi][coli] = *(local + (rowi - firstAction(rown))*actions[coln] + (coli - firstAction(coln)));
+	    } else {
+	      dest[rowi][coli] = *(local + (coli - firstAction(coln))*actions[rown] + (rowi - firstAction(rown)));
 	    }
 	  }
-        }
+	}
       }
     }
-    delete [] local;
-    delete [] m;
-  }
-  catch (...) {
-    delete [] local;
-    delete [] m;
-    throw;
   }
 }
 
 
-//assumes m = memcpy(m, payoffs + blockSize[numPlayers] * player1, blockSize[numPlayers]*sizeof(double)), player1 != player2
-//i.e. m points to payoff cmatrix for the desired player
+// m points to the payoff block for the desired player, or to the part of
+// it reached so far by the recursion; w points to the same position in
+// the workspace, into which contractions are written.  Once the first
+// contraction has been made, m and w coincide.  player1 != player2.
 
-void nfgame::localPayoffMatrix(double *dest, int player1, int player2, cvector &s, double *m, int n) {
+void nfgame::localPayoffMatrix(double *dest, int player1, int player2, cvector &s, const double *m, double *w, int n) {
   int i;
   if(player1 == n) {
     for(i = 0; i < actions[player1]; i++) {
-      localPayoffVector(dest+i*actions[player2], player2, s, m+i*blockSize[player1], n-1);
+      localPayoffVector(dest+i*actions[player2], player2, s, m+i*blockSize[player1], w+i*blockSize[player1], n-1);
     }
   } else if(player2 == n) {
     for(i = 0; i < actions[player2]; i++) {
-      localPayoffVector(dest+i*actions[player1], player1, s, m+i*blockSize[player2], n-1);
+      localPayoffVector(dest+i*actions[player1], player1, s, m+i*blockSize[player2], w+i*blockSize[player2], n-1);
     }
   } else {
-    m = scaleMatrix(s, m, n);
-    localPayoffMatrix(dest, player1, player2, s, m, n-1);
+    w = contractMatrix(s, m, w, n);
+    localPayoffMatrix(dest, player1, player2, s, w, w, n-1);
   }
 }
 
-double *nfgame::scaleMatrix(cvector &s, double *m, int n) {
-  int i,j, curbase, newbase = -1;
-  double scale;
+// Sums the blocks of m along dimension n, weighted by the strategy of
+// player n, and writes the result to the start of w.  m may be the same
+// as w, since each block is read only after the one it overwrites.
+// Blocks of actions played with probability zero are skipped.
+
+double *nfgame::contractMatrix(cvector &s, const double *m, double *w, int n) {
+  int i, j, size = blockSize[n];
+  bool first = true;
+  const double *sn = s.values() + firstAction(n);
   for(i = 0; i < actions[n]; i++) {
-    if(s[i+firstAction(n)] > 0.0) {
-      scale = s[i+firstAction(n)];
-      curbase = i*blockSize[n];
-      if(newbase < 0) {
-	newbase = curbase;
-	for(j = curbase; j < curbase+blockSize[n]; j++) {
-	  m[j] *= scale;
+    if(sn[i] > 0.0) {
+      const double scale = sn[i];
+      const double *cur = m + i*size;
+      if(first) {
+	for(j = 0; j < size; j++) {
+	  w[j] = scale * cur[j];
 	}
+	first = false;
       } else {
-	for(j = 0; j < blockSize[n]; j++) {
-	  m[newbase + j] += scale * m[curbase+j];
+	for(j = 0; j < size; j++) {
+	  w[j] += scale * cur[j];
 	}
       }
     }
   }
-  return m+newbase;
+  if(first) {
+    for(j = 0; j < size; j++) {
+      w[j] = 0.0;
+    }
+  }
+  return w;
 }
 
-void nfgame::localPayoffVector(double *dest, int player, cvector &s, double *m, int n) {
+void nfgame::localPayoffVector(double *dest, int player, cvector &s, const double *m, double *w, int n) {
   if(player == n) {
     for(int i = 0; i < actions[player]; i++) {
-      dest[i] = localPayoff(s, m+i*blockSize[player], n-1);
+      dest[i] = localPayoff(s, m+i*blockSize[player], w+i*blockSize[player], n-1);
     }
   } else {
-    m = scaleMatrix(s, m, n);
-    localPayoffVector(dest, player, s, m, n-1);
+    w = contractMatrix(s, m, w, n);
+    localPayoffVector(dest, player, s, w, w, n-1);
   }
 }
 
-double nfgame::localPayoff(cvector &s, double *m, int n) {
+double nfgame::localPayoff(cvector &s, const double *m, double *w, int n) {
   if(n < 0)
     return *m;
   else {
-    m = scaleMatrix(s, m, n);
-    return localPayoff(s, m, n-1);
+    w = contractMatrix(s, m, w, n);
+    return localPayoff(s, w, w, n-1);
   }
 }
@@ -27,8 +27,18 @@ class nfgame : public gnmgame {
  public:
   friend ostream& operator<< (ostream& s, nfgame& g);
   nfgame(int numPlayers, int *actions, const cvector &payoffs);
+  // Creates a game viewing the payoffs, in the same layout as above,
+  // without copying them.  They must outlive the game, and are not
+  // changed by it: setting a payoff first makes a copy of its own.
+  nfgame(int numPlayers, int *actions, const double *payoffs);
   ~nfgame();
 
+  // Returns a game sharing the payoffs of this one, with workspaces of
+  // its own, so that the two can be used by different threads at once.
+  // This game must outlive the new one, and its payoffs must not be set
+  // while the new one is in use.
+  gnmgame *makeWorkspace();
+
   // Input: s[i] has integer index of player i's pure strategy
   // s is of length numPlayers
   inline double getPurePayoff(int player, int *s) {
@@ -36,7 +46,8 @@ class nfgame : public gnmgame {
   }
 
   inline void setPurePayoff(int player, int *s, double value) {
-    payoffs[findIndex(player, s)]= value;
+    if(!ownPayoffs) copyPayoffs();
+    (*ownPayoffs)[findIndex(player, s)]= value;
   }
 
   double getMixedPayoff(int player, cvector &s);
@@ -47,12 +58,24 @@ class nfgame : public gnmgame {
 
  private:
   int findIndex(int player, int *s);
-  void localPayoffMatrix(double *dest, int player1, int player2, cvector &s, double *m, int n);
-  void localPayoffVector(double *dest, int player, cvector &s, double *m, int n);
-  double localPayoff(cvector &s, double *m, int n);
-  double *scaleMatrix(cvector &s, double *m, int n);
-  cvector payoffs;
+  void localPayoffMatrix(double *dest, int player1, int player2, cvector &s, const double *m, double *w, int n);
+  void localPayoffVector(double *dest, int player, cvector &s, const double *m, double *w, int n);
+  double localPayoff(cvector &s, const double *m, double *w, int n);
+  double *contractMatrix(cvector &s, const double *m, double *w, int n);
+  void init();
+  void copyPayoffs();
+  // used by makeWorkspace(): shares the payoffs of g
+  nfgame(const nfgame &g);
+  // the payoffs, which are in ownPayoffs if they belong to this game,
+  // and otherwise are viewed, or shared with the game this is a
+  // workspace of (in which case ownPayoffs is NULL)
+  const double *payoffs;
+  cvector *ownPayoffs;
   int *blockSize;
+  // Workspaces for contracting the payoffs, allocated once so that the
+  // payoff functions do no allocation.  An nfgame therefore may not be
+  // used by more than one thread at a time.
+  double *work, *local;
 };
 inline ostream& operator<< (ostream& s, nfgame& g){
 
@@ -62,7 +85,7 @@ inline ostream& operator<< (ostream& s, nfgame& g){
     s<< g.actions[i];
   }
   s<<endl;
-  s << g.payoffs;
+  s << cvector(const_cast<double *>(g.payoffs), g.numPlayers*g.blockSize[g.numPlayers]);
   s<<endl;
   return s;
 }
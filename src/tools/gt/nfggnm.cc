@@ -26,7 +26,10 @@
 #include <iostream>
 #include <fstream>
 #include <cerrno>
+#include <vector>
 #include "libgambit/libgambit.h"
+#include "libgambit/parallel.h"
+#include "libgambit/gametable.h"
 
 #include "nfgame.h"
 #include "aggame.h"
@@ -45,6 +48,7 @@ const double THRESHOLD = 1e-2;
 int g_numDecimals = 6;
 bool g_verbose = false;
 int g_numVectors = 1;
+int g_numThreads = 0;
 std::string g_startFile;
 
 bool ReadProfile(std::istream &p_stream, cvector &p_profile)
@@ -87,6 +91,8 @@ void PrintHelp(char *progname)
   std::cerr << "Options:\n";
   std::cerr << "  -d DECIMALS      show equilibria as floating point with DECIMALS digits\n";
   std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  -j THREADS       number of threads to use (default is the\n";
+  std::cerr << "                   number of processors)\n";
   std::cerr << "  -n COUNT         number of perturbation vectors to generate\n";
   std::cerr << "  -s FILE          file containing perturbation vectors\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
@@ -96,6 +102,117 @@ void PrintHelp(char *progname)
   exit(1);
 }
 
+bool IsDuplicate(const cvector &p_profile, const std::vector<cvector> &p_list)
+{
+  for (size_t i = 0; i < p_list.size(); i++) {
+    bool same = true;
+    for (int j = 0; same && j < p_profile.getm(); j++) {
+      same = (std::abs(p_profile[j] - p_list[i][j]) < 1.0e-6);
+    }
+    if (same)  return true;
+  }
+  return false;
+}
+
+//
+// Follows the path from each of a list of perturbation rays, one piece
+// per ray.  Each thread uses a game of its own, sharing the payoffs of
+// the original, as the payoff computations of a game use workspaces
+// stored in it.  Equilibria are printed in the order of the rays,
+// omitting those already printed for an earlier ray.
+//
+class PerturbationTask : public Gambit::ParallelTask {
+private:
+  gnmgame &m_game;
+  std::vector<cvector> m_rays;
+  std::vector<std::vector<cvector> > m_equilibria;
+  std::vector<cvector> m_printed;
+  std::vector<gnmgame *> m_spares, m_workspaces;
+  Gambit::Mutex m_lock;
+
+  gnmgame *GetWorkspace(void);
+  void ReturnWorkspace(gnmgame *);
+
+public:
+  PerturbationTask(gnmgame &p_game, const std::vector<cvector> &p_rays);
+  ~PerturbationTask();
+
+  /// Returns true if the rays can be traced by several threads at once
+  bool IsShareable(void) const { return !m_workspaces.empty(); }
+
+  void Run(int p_piece);
+  bool Finish(int p_piece);
+};
+
+PerturbationTask::PerturbationTask(gnmgame &p_game,
+				   const std::vector<cvector> &p_rays)
+  : m_game(p_game), m_rays(p_rays), m_equilibria(p_rays.size())
+{
+  m_spares.push_back(&m_game);
+  gnmgame *workspace = m_game.makeWorkspace();
+  if (workspace) {
+    m_workspaces.push_back(workspace);
+    m_spares.push_back(workspace);
+  }
+}
+
+PerturbationTask::~PerturbationTask()
+{
+  for (size_t i = 0; i < m_workspaces.size(); i++) {
+    delete m_workspaces[i];
+  }
+}
+
+gnmgame *PerturbationTask::GetWorkspace(void)
+{
+  Gambit::MutexLock lock(m_lock);
+  if (m_spares.empty()) {
+    m_workspaces.push_back(m_game.makeWorkspace());
+    return m_workspaces.back();
+  }
+  gnmgame *workspace = m_spares.back();
+  m_spares.pop_back();
+  return workspace;
+}
+
+void PerturbationTask::ReturnWorkspace(gnmgame *p_workspace)
+{
+  Gambit::MutexLock lock(m_lock);
+  m_spares.push_back(p_workspace);
+}
+
+void PerturbationTask::Run(int p_piece)
+{
+  if (g_verbose) {
+    PrintProfile(std::cout, "pert", m_rays[p_piece]);
+  }
+
+  gnmgame *game = GetWorkspace();
+  cvector **answers;
+  int numEq = GNM(*game, m_rays[p_piece], answers, STEPS, FUZZ,
+		  LNMFREQ, LNMMAX, LAMBDAMIN, WOBBLE, THRESHOLD);
+  ReturnWorkspace(game);
+
+  for (int i = 0; i < numEq; i++) {
+    m_equilibria[p_piece].push_back(*answers[i]);
+    delete answers[i];
+  }
+  free(answers);
+}
+
+bool PerturbationTask::Finish(int p_piece)
+{
+  const std::vector<cvector> &equilibria = m_equilibria[p_piece];
+  for (size_t i = 0; i < equilibria.size(); i++) {
+    if (!IsDuplicate(equilibria[i], m_printed)) {
+      PrintProfile(std::cout, "NE", equilibria[i]);
+      m_printed.push_back(equilibria[i]);
+    }
+  }
+  m_equilibria[p_piece] = std::vector<cvector>();
+  return true;
+}
+
 void Solve(const Gambit::Game &p_game)
 {
   int i;
@@ -116,47 +233,53 @@ void Solve(const Gambit::Game &p_game)
     }
     cvector payoffs(veclength);
   
-    A = new nfgame(p_game->NumPlayers(), actions, payoffs);
-  
-    int *profile = new int[p_game->NumPlayers()];
-    for (Gambit::StrategyProfileIterator iter(p_game); !iter.AtEnd(); iter++) {
-      for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
-        profile[pl-1] = (*iter)->GetStrategy(pl)->GetNumber() - 1;
+    const Gambit::GameTableRep *table =
+      dynamic_cast<const Gambit::GameTableRep *>(&*p_game);
+    if (table) {
+      // The dense payoff table of the game has the layout used by
+      // nfgame, so the payoffs only need to be scaled
+      const double *values = table->GetPayoffTable<double>(1);
+      double shift = (double) minPay;
+      for (i = 0; i < veclength; i++) {
+	payoffs[i] = (values[i] - shift) * scale;
       }
+      A = new nfgame(p_game->NumPlayers(), actions, payoffs);
+    }
+    else {
+      A = new nfgame(p_game->NumPlayers(), actions, payoffs);
+  
+      int *profile = new int[p_game->NumPlayers()];
+      for (Gambit::StrategyProfileIterator iter(p_game); !iter.AtEnd(); iter++) {
+	for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+	  profile[pl-1] = (*iter)->GetStrategy(pl)->GetNumber() - 1;
+	}
 
-      for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
-        A->setPurePayoff(pl-1, profile,
-		       (double) ((*iter)->GetPayoff(pl) - minPay) *
-		       scale);
+	for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+	  A->setPurePayoff(pl-1, profile,
+			   (double) ((*iter)->GetPayoff(pl) - minPay) *
+			   scale);
+	}
       }
     }
   }
 
-  cvector g(A->getNumActions()); // choose a random perturbation ray
-  int numEq;
+  // Collect the perturbation rays before tracing any, so that the rays
+  // generated do not depend on the order in which they are traced
+  std::vector<cvector> rays;
+  cvector g(A->getNumActions());
 
   if (g_startFile != "") {
     std::ifstream startVectors(g_startFile.c_str());
 
     while (!startVectors.eof() && !startVectors.bad()) {
-      cvector **answers;
       if (ReadProfile(startVectors, g)) {
 	g /= g.norm(); // normalized
-	if (g_verbose) {
-	  PrintProfile(std::cout, "pert", g);
-	}
-
-	numEq = GNM(*A, g, answers, STEPS, FUZZ, LNMFREQ, LNMMAX, LAMBDAMIN, WOBBLE, THRESHOLD);
-	for (i = 0; i < numEq; i++) {
-	  free(answers[i]);
-	}
-	free(answers);
+	rays.push_back(g);
       }
     }
   }
   else {
     for (int iter = 0; iter < g_numVectors; iter++) {
-      cvector **answers;
       for(i = 0; i < A->getNumActions(); i++) {
 #if !defined(HAVE_DRAND48)
 	g[i] = rand();
@@ -165,17 +288,16 @@ void Solve(const Gambit::Game &p_game)
 #endif  // HAVE_DRAND48
       }
       g /= g.norm(); // normalized
-      if (g_verbose) {
-	PrintProfile(std::cout, "pert", g);
-      }
-      numEq = GNM(*A, g, answers, STEPS, FUZZ, LNMFREQ, LNMMAX, LAMBDAMIN, WOBBLE, THRESHOLD);
-      for (i = 0; i < numEq; i++) {
-	free(answers[i]);
-      }
-      free(answers);
+      rays.push_back(g);
     }
   }
 
+  PerturbationTask task(*A, rays);
+  // Verbose output traces each path as it is followed, so the paths
+  // are then followed one at a time
+  Gambit::RunParallel(task, rays.size(),
+		      (g_verbose || !task.IsShareable()) ? 1 : g_numThreads);
+
   delete A;
 }
 
@@ -192,7 +314,7 @@ int main(int argc, char *argv[])
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "d:n:s:qvVhS", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:j:n:s:qvVhS", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -205,6 +327,9 @@ int main(int argc, char *argv[])
     case 'd':
       g_numDecimals = atoi(optarg);
       break;
+    case 'j':
+      g_numThreads = atoi(optarg);
+      break;
     case 'n':
       g_numVectors = atoi(optarg);
       break;
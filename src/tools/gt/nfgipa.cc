@@ -27,6 +27,7 @@
 #include <fstream>
 #include <cerrno>
 #include "libgambit/libgambit.h"
+#include "libgambit/gametable.h"
 
 #include "nfgame.h"
 #include "aggame.h"
@@ -86,19 +87,29 @@ void Solve(const Gambit::Game &p_game, const Gambit::Array<double> &p_pert)
       actions[pl-1] = p_game->GetPlayer(pl)->NumStrategies();
       veclength *= p_game->GetPlayer(pl)->NumStrategies();
     }
-    cvector payoffs(veclength);
+    const Gambit::GameTableRep *table =
+      dynamic_cast<const Gambit::GameTableRep *>(&*p_game);
+    if (table) {
+      // The dense payoff table of the game has the layout used by
+      // nfgame, and outlives it, so it can be used without copying
+      A = new nfgame(p_game->NumPlayers(), actions,
+		     table->GetPayoffTable<double>(1));
+    }
+    else {
+      cvector payoffs(veclength);
   
-    A = new nfgame(p_game->NumPlayers(), actions, payoffs);
+      A = new nfgame(p_game->NumPlayers(), actions, payoffs);
   
-    int *profile = new int[p_game->NumPlayers()];
-    for (Gambit::StrategyProfileIterator iter(p_game); !iter.AtEnd(); iter++) {
-     for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
-      profile[pl-1] = (*iter)->GetStrategy(pl)->GetNumber() - 1;
-     }
-
-     for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
-      A->setPurePayoff(pl-1, profile, (*iter)->GetPayoff(pl));
-     }
+      int *profile = new int[p_game->NumPlayers()];
+      for (Gambit::StrategyProfileIterator iter(p_game); !iter.AtEnd(); iter++) {
+	for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+	  profile[pl-1] = (*iter)->GetStrategy(pl)->GetNumber() - 1;
+	}
+
+	for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+	  A->setPurePayoff(pl-1, profile, (*iter)->GetPayoff(pl));
+	}
+      }
     }
   }
 
@@ -24,6 +24,8 @@
 #include <cstdio>
 #include <unistd.h>
 #include <iostream>
+#include <set>
+#include <vector>
 #include "libgambit/libgambit.h"
 #include "efglcp.h"
 
@@ -32,22 +34,58 @@ using namespace Gambit;
 #include "lhtab.h"
 #include "lemketab.h"
 
+//
+// A Lemke path being followed from a CBFS, on a tableau using its own
+// copy of the constraint matrix, perturbed in the row for that path.
+//
+template <class T> class NashLcpBehaviorSolver<T>::Path {
+public:
+  SparseMatrix<T> m_matrix;
+  LTableau<T> m_tableau;
+  BFS<T> m_bfs;
+
+  Path(const SparseMatrix<T> &p_matrix, const LTableau<T> &p_tableau)
+    : m_matrix(p_matrix), m_tableau(p_tableau)
+  { m_tableau.Set_A(m_matrix); }
+
+  /// Resets the path to start from the tableau, reusing the storage
+  void Assign(const SparseMatrix<T> &p_matrix, const LTableau<T> &p_tableau)
+  {
+    m_matrix = p_matrix;
+    m_tableau = p_tableau;
+    m_tableau.Set_A(m_matrix);
+  }
+
+  bool SharesFactorization(void) const
+  { return m_tableau.SharesFactorization(); }
+};
+
 template <class T> class NashLcpBehaviorSolver<T>::Solution {
 public:
   int ns1, ns2, ni1, ni2;
   Rational maxpay;
   T eps;
   List<GameInfoset> isets1, isets2;
-  List<BFS<T> > m_list;
+  // The equilibria found, which are only counted when streaming
   List<MixedBehaviorProfile<T> > m_equilibria;
+  int m_numEquilibria;
+  TableauPool<Path> m_pool;
 
-  bool AddBFS(const LTableau<T> &);
+  Solution(void) : m_numEquilibria(0) { }
 
-  int EquilibriumCount(void) const { return m_equilibria.size(); }
+  static BFS<T> GetBFS(const LTableau<T> &);
+  bool AddBFS(const BFS<T> &);
+  bool AddBFS(const LTableau<T> &tableau) { return AddBFS(GetBFS(tableau)); }
+
+  int EquilibriumCount(void) const { return m_numEquilibria; }
+
+private:
+  // The bases visited
+  std::set<BFS<T> > m_bfsSet;
 };
 
-template <class T> bool 
-NashLcpBehaviorSolver<T>::Solution::AddBFS(const LTableau<T> &tableau)
+template <class T> BFS<T>
+NashLcpBehaviorSolver<T>::Solution::GetBFS(const LTableau<T> &tableau)
 {
   BFS<T> cbfs;
   Vector<T> v(tableau.MinRow(), tableau.MaxRow());
@@ -58,14 +96,61 @@ NashLcpBehaviorSolver<T>::Solution::AddBFS(const LTableau<T> &tableau)
       cbfs.insert(i, v[tableau.Find(i)]);
     }
   }
+  return cbfs;
+}
 
-  if (!m_list.Contains(cbfs)) {
-    m_list.push_back(cbfs);
-    return true;
+template <class T> bool 
+NashLcpBehaviorSolver<T>::Solution::AddBFS(const BFS<T> &cbfs)
+{
+  return m_bfsSet.insert(cbfs).second;
+}
+
+//
+// Follows the Lemke path leaving the CBFS of p_tableau through the row
+// given, on a copy of the tableau using its own copy of the constraint
+// matrix, with the covering vector perturbed in that row.  Returns the
+// path if it ends at a CBFS not yet visited, which is then recorded as
+// visited, and null otherwise.
+//
+template <class T> typename NashLcpBehaviorSolver<T>::Path *
+NashLcpBehaviorSolver<T>::FollowPath(const LTableau<T> &p_tableau,
+				     const SparseMatrix<T> &p_matrix,
+				     int p_dup, int p_row, int p_depth,
+				     Solution &p_solution) const
+{
+  Path *path = p_solution.m_pool.Acquire();
+  if (path) {
+    path->Assign(p_matrix, p_tableau);
   }
   else {
-    return false;
+    path = new Path(p_matrix, p_tableau);
   }
+
+  try {
+    path->m_matrix.Set(p_row, 0, -((T) 1 / (T) 1000));
+    path->m_tableau.Refactor();
+
+    int missing;
+    if (p_depth == 0) {
+      path->m_tableau.Pivot(p_dup, 0);
+      missing = -p_dup;
+    }
+    else {
+      missing = path->m_tableau.SF_PivotIn(0);
+    }
+
+    if (path->m_tableau.SF_LCPPath(-missing) == 1 &&
+	p_solution.AddBFS(path->m_tableau)) {
+      return path;
+    }
+    // gout << ": Dead End";
+  }
+  catch (...) {
+    p_solution.m_pool.Release(path);
+    throw;
+  }
+  p_solution.m_pool.Release(path);
+  return 0;
 }
 
 //
@@ -85,7 +170,7 @@ NashLcpBehaviorSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
   }
 
   BFS<T> cbfs;
-  int i, j;
+  int i;
   Solution solution;
 
   solution.isets1 = p_support.ReachableInfosets(p_support.GetGame()->GetPlayer(1));
@@ -99,28 +184,26 @@ NashLcpBehaviorSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
 
   ntot = solution.ns1+solution.ns2+solution.ni1+solution.ni2;
 
-  Matrix<T> A(1,ntot,0,ntot);
+  // The sequence-form matrix has few nonzeros per row, so it is held
+  // sparsely; the tableau on it grows with the number of nonzeros,
+  // rather than with the square of the number of sequences
+  SparseMatrix<T> A(1,ntot,0,ntot);
   Vector<T> b(1,ntot);
 
   solution.maxpay = p_support.GetGame()->GetMaxPayoff() + Rational(1);
 
   T prob = (T)1;
-  for (i = A.MinRow(); i <= A.MaxRow(); i++) {
-    b[i] = (T) 0;
-    for (j = A.MinCol(); j <= A.MaxCol(); j++) {
-      A(i,j) = (T) 0; 
-    }
-  }
+  b = (T) 0;
 
   FillTableau(p_support, A, p_support.GetGame()->GetRoot(), prob, 1, 1, 0, 0,
 	      solution);
   for (i = A.MinRow(); i <= A.MaxRow(); i++) { 
-    A(i,0) = -(T) 1;
+    A.Set(i,0,-(T) 1);
   }
-  A(1,solution.ns1+solution.ns2+1) = (T) 1;
-  A(solution.ns1+solution.ns2+1,1) = -(T) 1;
-  A(solution.ns1+1,solution.ns1+solution.ns2+solution.ni1+1) = (T) 1;
-  A(solution.ns1+solution.ns2+solution.ni1+1,solution.ns1+1) = -(T) 1;
+  A.Set(1,solution.ns1+solution.ns2+1,(T) 1);
+  A.Set(solution.ns1+solution.ns2+1,1,-(T) 1);
+  A.Set(solution.ns1+1,solution.ns1+solution.ns2+solution.ni1+1,(T) 1);
+  A.Set(solution.ns1+solution.ns2+solution.ni1+1,solution.ns1+1,-(T) 1);
   b[solution.ns1+solution.ns2+1] = -(T)1;
   b[solution.ns1+solution.ns2+solution.ni1+1] = -(T)1;
 
@@ -151,8 +234,10 @@ NashLcpBehaviorSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
 		 profile,sol,p_support.GetGame()->GetRoot(), 1, 1,
 		 solution);
       profile.UndefinedToCentroid();
-      solution.m_equilibria.push_back(profile);
       this->m_onEquilibrium->Render(profile);
+      if (!this->m_streaming) {
+	solution.m_equilibria.push_back(profile);
+      }
     }
   }
   catch (std::runtime_error &e) {
@@ -166,73 +251,60 @@ NashLcpBehaviorSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
 // All_Lemke finds all accessible Nash equilibria by recursively 
 // calling itself.  List maintains the list of basic variables 
 // for the equilibria that have already been found.  
-// From each new accessible equilibrium, it follows
-// all possible paths, adding any new equilibria to the List.  
+// The paths leaving an equilibrium are tried in order, and the search
+// continues from the end of the first which leads to an equilibrium
+// not yet found.
 //
 template <class T> void
 NashLcpBehaviorSolver<T>::AllLemke(const BehaviorSupportProfile &p_support,
 				   int j, LTableau<T> &B, int depth,
-				   Matrix<T> &A,
+				   const SparseMatrix<T> &A,
 				   Solution &p_solution) const
 {
   if (m_maxDepth != 0 && depth > m_maxDepth) {
     return;
   }
 
-  T small_num = (T)1/(T)1000;
-
-  Vector<T> sol(B.MinRow(),B.MaxRow());
-  MixedBehaviorProfile<T> profile(p_support);
-
-  bool newsol = false;
-  for (int i = B.MinRow(); i <= B.MaxRow() && !newsol; i++) {
+  for (int i = B.MinRow(); i <= B.MaxRow(); i++) {
     if (i == j) continue;
 
-    LTableau<T> BCopy(B);
-    A(i,0) = -small_num;
-    BCopy.Refactor();
-
-    int missing;
-    if (depth == 0) {
-      BCopy.Pivot(j, 0);
-      missing = -j;
-    }
-    else {
-      missing = BCopy.SF_PivotIn(0);
-    }
-
-    newsol = false;
+    Path *path = FollowPath(B, A, j, i, depth, p_solution);
+    if (!path) continue;
 
-    if (BCopy.SF_LCPPath(-missing) == 1) {
-      newsol = p_solution.AddBFS(BCopy);
-      BCopy.BasisVector(sol);
-      GetProfile(p_support, BCopy, profile, sol,
-		 p_support.GetGame()->GetRoot(), 1, 1,
-		 p_solution);
+    try {
+      LTableau<T> &tableau = path->m_tableau;
+      Vector<T> sol(tableau.MinRow(), tableau.MaxRow());
+      MixedBehaviorProfile<T> profile(p_support);
+      tableau.BasisVector(sol);
+      GetProfile(p_support, tableau, profile, sol,
+		 p_support.GetGame()->GetRoot(), 1, 1, p_solution);
       profile.UndefinedToCentroid();
-      if (newsol) {
-	this->m_onEquilibrium->Render(profile);
+      this->m_onEquilibrium->Render(profile);
+      p_solution.m_numEquilibria++;
+      if (!this->m_streaming) {
 	p_solution.m_equilibria.push_back(profile);
-	if (m_stopAfter > 0 && p_solution.EquilibriumCount() >= m_stopAfter) {
-	  throw NashEquilibriumLimitReached();
-	}
       }
+      if (m_stopAfter > 0 && p_solution.EquilibriumCount() >= m_stopAfter) {
+	throw NashEquilibriumLimitReached();
+      }
+
+      // The path is continued from the tableau without the perturbation
+      tableau.Set_A(A);
+      tableau.Refactor();
+      AllLemke(p_support, i, tableau, depth+1, A, p_solution);
     }
-    else {
-      // gout << ": Dead End";
-    }
-      
-    A(i,0) = (T) -1;
-    if (newsol) {
-      BCopy.Refactor();
-      AllLemke(p_support, i, BCopy, depth+1, A, p_solution);
+    catch (...) {
+      p_solution.m_pool.Release(path);
+      throw;
     }
+    p_solution.m_pool.Release(path);
+    return;
   }
 }
 
 template <class T>
 void NashLcpBehaviorSolver<T>::FillTableau(const BehaviorSupportProfile &p_support, 
-					Matrix<T> &A,
+					SparseMatrix<T> &A,
 					const GameNode &n, T prob,
 					int s1, int s2, int i1, int i2,
 					Solution &p_solution) const
@@ -244,10 +316,10 @@ void NashLcpBehaviorSolver<T>::FillTableau(const BehaviorSupportProfile &p_suppo
 
   GameOutcome outcome = n->GetOutcome();
   if (outcome) {
-    A(s1,ns1+s2) = Rational(A(s1,ns1+s2)) +
-      Rational(prob) * (outcome->GetPayoff<Rational>(1) - p_solution.maxpay);
-    A(ns1+s2,s1) = Rational(A(ns1+s2,s1)) +
-      Rational(prob) * (outcome->GetPayoff<Rational>(2) - p_solution.maxpay);
+    A.Set(s1,ns1+s2,Rational(A(s1,ns1+s2)) +
+	  Rational(prob) * (outcome->GetPayoff<Rational>(1) - p_solution.maxpay));
+    A.Set(ns1+s2,s1,Rational(A(ns1+s2,s1)) +
+	  Rational(prob) * (outcome->GetPayoff<Rational>(2) - p_solution.maxpay));
   }
   if (n->GetInfoset()) {
     if (n->GetPlayer()->IsChance()) {
@@ -266,11 +338,11 @@ void NashLcpBehaviorSolver<T>::FillTableau(const BehaviorSupportProfile &p_suppo
 	snew+=p_support.NumActions(p_solution.isets1[i]->GetPlayer()->GetNumber(),
 				   p_solution.isets1[i]->GetNumber());
       }
-      A(s1,ns1+ns2+i1+1) = -(T)1;
-      A(ns1+ns2+i1+1,s1) = (T)1;
+      A.Set(s1,ns1+ns2+i1+1,-(T)1);
+      A.Set(ns1+ns2+i1+1,s1,(T)1);
       for (int i = 1; i <= p_support.NumActions(n->GetInfoset()->GetPlayer()->GetNumber(), n->GetInfoset()->GetNumber()); i++) {
-	A(snew+i,ns1+ns2+i1+1) = (T)1;
-	A(ns1+ns2+i1+1,snew+i) = -(T)1;
+	A.Set(snew+i,ns1+ns2+i1+1,(T)1);
+	A.Set(ns1+ns2+i1+1,snew+i,-(T)1);
 	FillTableau(p_support, A, n->GetChild(p_support.GetAction(n->GetInfoset()->GetPlayer()->GetNumber(), n->GetInfoset()->GetNumber(), i)->GetNumber()),prob,snew+i,s2,i1,i2, p_solution);
       }
     }
@@ -281,11 +353,11 @@ void NashLcpBehaviorSolver<T>::FillTableau(const BehaviorSupportProfile &p_suppo
 	snew+=p_support.NumActions(p_solution.isets2[i]->GetPlayer()->GetNumber(),
 				   p_solution.isets2[i]->GetNumber());
       }
-      A(ns1+s2,ns1+ns2+ni1+i2+1) = -(T)1;
-      A(ns1+ns2+ni1+i2+1,ns1+s2) = (T)1;
+      A.Set(ns1+s2,ns1+ns2+ni1+i2+1,-(T)1);
+      A.Set(ns1+ns2+ni1+i2+1,ns1+s2,(T)1);
       for (int i = 1; i <= p_support.NumActions(n->GetInfoset()->GetPlayer()->GetNumber(), n->GetInfoset()->GetNumber()); i++) {
-	A(ns1+snew+i,ns1+ns2+ni1+i2+1) = (T)1;
-	A(ns1+ns2+ni1+i2+1,ns1+snew+i) = -(T)1;
+	A.Set(ns1+snew+i,ns1+ns2+ni1+i2+1,(T)1);
+	A.Set(ns1+ns2+ni1+i2+1,ns1+snew+i,-(T)1);
 	FillTableau(p_support, A, n->GetChild(p_support.GetAction(n->GetInfoset()->GetPlayer()->GetNumber(), n->GetInfoset()->GetNumber(), i)->GetNumber()),prob,s1,snew+i,i1,i2, p_solution);
       }
     }
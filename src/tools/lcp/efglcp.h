@@ -28,6 +28,7 @@
 using namespace Gambit;
 
 template <class T> class LTableau;
+template <class T> class SparseMatrix;
 
 template <class T> class NashLcpBehaviorSolver : public NashBehavSolver<T> {
 public:
@@ -43,11 +44,14 @@ private:
   int m_stopAfter, m_maxDepth;
 
   class Solution;
+  class Path;
 
-  void FillTableau(const BehaviorSupportProfile &, Matrix<T> &, const GameNode &, T,
-		   int, int, int, int, Solution &) const;
+  void FillTableau(const BehaviorSupportProfile &, SparseMatrix<T> &, 
+		   const GameNode &, T, int, int, int, int, Solution &) const;
+  Path *FollowPath(const LTableau<T> &, const SparseMatrix<T> &,
+		   int dup, int row, int depth, Solution &) const;
   void AllLemke(const BehaviorSupportProfile &, int dup, LTableau<T> &B,
-	       int depth, Matrix<T> &, Solution &) const; 
+	       int depth, const SparseMatrix<T> &, Solution &) const; 
   void GetProfile(const BehaviorSupportProfile &, const LTableau<T> &tab, 
 		  MixedBehaviorProfile<T> &, const Vector<T> &, 
 		  const GameNode &n, int, int,
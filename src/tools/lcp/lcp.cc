@@ -49,13 +49,21 @@ void PrintHelp(char *progname)
   std::cerr << "Options:\n";
   std::cerr << "  -d DECIMALS      compute using floating-point arithmetic;\n";
   std::cerr << "                   display results with DECIMALS digits\n";
+  std::cerr << "  -H               follow paths in floating point, and check the\n";
+  std::cerr << "                   equilibria found in exact arithmetic\n";
+  std::cerr << "                   (strategic games, or with -S, only;\n";
+  std::cerr << "                   not with -d)\n";
   std::cerr << "  -S               use strategic game\n";
   std::cerr << "  -P               find only subgame-perfect equilibria\n";
   std::cerr << "  -e EQA           terminate after finding EQA equilibria\n";
   std::cerr << "                   (default is to find all accessible equilbria\n";
   std::cerr << "  -r DEPTH         terminate recursion at DEPTH\n";
   std::cerr << "                   (only if number of equilibria sought is not 1)\n";
+  std::cerr << "  -j THREADS       number of threads to use (default is the\n";
+  std::cerr << "                   number of processors; strategic games only)\n";
   std::cerr << "  -D               print detailed information about equilibria\n";
+  std::cerr << "  -B               print equilibria in a binary format, for use\n";
+  std::cerr << "                   by other programs\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -v, --version    print version information\n";
@@ -67,8 +75,8 @@ int main(int argc, char *argv[])
 {
   int c;
   bool useFloat = false, useStrategic = false, bySubgames = false, quiet = false;
-  bool printDetail = false;
-  int numDecimals = 6, stopAfter = 0, maxDepth = 0;
+  bool printDetail = false, printBinary = false, useHybrid = false;
+  int numDecimals = 6, stopAfter = 0, maxDepth = 0, threads = 0;
 
   int long_opt_index = 0;
   struct option long_options[] = {
@@ -76,7 +84,7 @@ int main(int argc, char *argv[])
     { "version", 0, NULL, 'v'  },
     { 0,    0,    0,    0   }
   };
-  while ((c = getopt_long(argc, argv, "d:DvhqSPe:r:", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:DvhqSPHe:r:j:B", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -93,15 +101,24 @@ int main(int argc, char *argv[])
     case 'h':
       PrintHelp(argv[0]);
       break;
+    case 'B':
+      printBinary = true;
+      break;
     case 'q':
       quiet = true;
       break;
     case 'r':
       maxDepth = atoi(optarg);
       break;
+    case 'j':
+      threads = atoi(optarg);
+      break;
     case 'S':
       useStrategic = true;
       break;
+    case 'H':
+      useHybrid = true;
+      break;
     case 'P':
       bySubgames = true;
       break;
@@ -122,6 +139,11 @@ int main(int argc, char *argv[])
     PrintBanner(std::cerr);
   }
 
+  if (useHybrid && useFloat) {
+    std::cerr << argv[0] << ": Options -H and -d cannot be used together.\n";
+    return 1;
+  }
+
   std::istream* input_stream = &std::cin;
   std::ifstream file_stream;
   if (optind < argc) {
@@ -137,10 +159,16 @@ int main(int argc, char *argv[])
 
   try {
     Game game = ReadGame(*input_stream);
+    if (useHybrid && game->IsTree() && !useStrategic) {
+      throw UndefinedException("Option -H applies to extensive games only with -S.");
+    }
     if (!game->IsTree() || useStrategic) {
       if (useFloat) {
 	shared_ptr<StrategyProfileRenderer<double> > renderer;
-	if (printDetail)  {
+	if (printBinary) {
+	  renderer = new MixedStrategyBinaryRenderer<double>(std::cout);
+	}
+	else if (printDetail) {
 	  renderer = new MixedStrategyDetailRenderer<double>(std::cout,
 							     numDecimals);
 	}
@@ -148,19 +176,24 @@ int main(int argc, char *argv[])
 	  renderer = new MixedStrategyCSVRenderer<double>(std::cout, numDecimals);
 	}
 	NashLcpStrategySolver<double> algorithm(stopAfter, maxDepth,
-						renderer);
+						renderer, threads);
+	algorithm.SetStreaming(true);
 	algorithm.Solve(game);
       }
       else {
 	shared_ptr<StrategyProfileRenderer<Rational> > renderer;
-	if (printDetail) {
+	if (printBinary) {
+	  renderer = new MixedStrategyBinaryRenderer<Rational>(std::cout);
+	}
+	else if (printDetail) {
 	  renderer = new MixedStrategyDetailRenderer<Rational>(std::cout);
 	}
 	else {
 	  renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
 	}
 	NashLcpStrategySolver<Rational> algorithm(stopAfter, maxDepth,
-						  renderer);
+						  renderer, threads, useHybrid);
+	algorithm.SetStreaming(true);
 	algorithm.Solve(game);
       }
     }
@@ -168,7 +201,10 @@ int main(int argc, char *argv[])
       if (!bySubgames) {
 	if (useFloat) {
 	  shared_ptr<StrategyProfileRenderer<double> > renderer;
-	  if (printDetail)  {
+	  if (printBinary) {
+	    renderer = new BehavStrategyBinaryRenderer<double>(std::cout);
+	  }
+	  else if (printDetail) {
 	    renderer = new BehavStrategyDetailRenderer<double>(std::cout,
 							       numDecimals);
 	  }
@@ -177,17 +213,22 @@ int main(int argc, char *argv[])
 							    numDecimals);
 	  }
 	  NashLcpBehaviorSolver<double> algorithm(stopAfter, maxDepth, renderer);
+	  algorithm.SetStreaming(true);
 	  algorithm.Solve(game);
 	}
 	else {
 	  shared_ptr<StrategyProfileRenderer<Rational> > renderer;
-	  if (printDetail) {
+	  if (printBinary) {
+	    renderer = new BehavStrategyBinaryRenderer<Rational>(std::cout);
+	  }
+	  else if (printDetail) {
 	    renderer = new BehavStrategyDetailRenderer<Rational>(std::cout);
 	  }
 	  else {
 	    renderer = new BehavStrategyCSVRenderer<Rational>(std::cout);
 	  }
 	  NashLcpBehaviorSolver<Rational> algorithm(stopAfter, maxDepth, renderer);
+	  algorithm.SetStreaming(true);
 	  algorithm.Solve(game);
 	}
       }
@@ -196,7 +237,10 @@ int main(int argc, char *argv[])
 	  shared_ptr<NashBehavSolver<double> > stage = 
 	    new NashLcpBehaviorSolver<double>(stopAfter, maxDepth);
 	  shared_ptr<StrategyProfileRenderer<double> > renderer;
-	  if (printDetail)  {
+	  if (printBinary) {
+	    renderer = new BehavStrategyBinaryRenderer<double>(std::cout);
+	  }
+	  else if (printDetail) {
 	    renderer = new BehavStrategyDetailRenderer<double>(std::cout,
 							       numDecimals);
 	  }
@@ -205,13 +249,17 @@ int main(int argc, char *argv[])
 							    numDecimals);
 	  }
 	  SubgameNashBehavSolver<double> algorithm(stage, renderer);
+	  algorithm.SetStreaming(true);
 	  algorithm.Solve(game);
 	}
 	else {
 	  shared_ptr<NashBehavSolver<Rational> > stage = 
 	    new NashLcpBehaviorSolver<Rational>(stopAfter, maxDepth);
 	  shared_ptr<StrategyProfileRenderer<Rational> > renderer;
-	  if (printDetail)  {
+	  if (printBinary) {
+	    renderer = new BehavStrategyBinaryRenderer<Rational>(std::cout);
+	  }
+	  else if (printDetail) {
 	    renderer = new BehavStrategyDetailRenderer<Rational>(std::cout,
 								 numDecimals);
 	  }
@@ -220,6 +268,7 @@ int main(int argc, char *argv[])
 							      numDecimals);
 	  }
 	  SubgameNashBehavSolver<Rational> algorithm(stage, renderer);
+	  algorithm.SetStreaming(true);
 	  algorithm.Solve(game);
 	}
       }
@@ -23,11 +23,15 @@
 #ifndef LEMKETAB_H
 #define LEMKETAB_H
 
+#include <vector>
+#include "libgambit/parallel.h"
 #include "liblinear/tableau.h"
 
 template <class T> class LTableau : public Tableau<T> {
 protected:
 //  T eps2;
+  long nties;
+
 public:
 //   LTableau(void);
   class BadPivot : public Gambit::Exception  {
@@ -41,6 +45,7 @@ public:
     const char *what(void) const throw() { return "Bad Exit Index in LTableau"; }
   };
   LTableau(const Gambit::Matrix<T> &A, const Gambit::Vector<T> &b);
+  LTableau(const SparseMatrix<T> &A, const Gambit::Vector<T> &b);
   LTableau(Tableau<T> &);
   virtual ~LTableau();
 
@@ -50,6 +55,69 @@ public:
   int PivotIn(int i);
   int ExitIndex(int i);
   int LemkePath(int dup); // follow a path of ACBFS's from one CBFS to another
+  // number of times ExitIndex found ratios equal to within the tolerance,
+  // and so chose the leaving variable by breaking a tie
+  long NumTies(void) const { return nties; }
+};
+
+//
+// A stock of tableaux no longer in use, kept so that their storage can
+// be reused when the search needs another snapshot of a tableau.
+// Restoring a snapshot into a recycled tableau by assignment reuses its
+// matrices and the storage of their entries, rather than allocating a
+// new copy for each path followed.  Tableaux whose factorization is
+// shared with the tableau they were copied from are not kept, since they
+// may not outlive it.  Tableaux may be taken and returned on any thread.
+//
+template <class Tab> class TableauPool {
+private:
+  std::vector<Tab *> m_spares;
+  Gambit::Mutex m_lock;
+
+  TableauPool(const TableauPool<Tab> &);
+  TableauPool<Tab> &operator=(const TableauPool<Tab> &);
+
+public:
+  TableauPool(void) { }
+  ~TableauPool()
+  {
+    for (size_t i = 0; i < m_spares.size(); i++) {
+      delete m_spares[i];
+    }
+  }
+
+  /// Returns a tableau no longer in use, or null if there is none
+  Tab *Acquire(void)
+  {
+    Gambit::MutexLock lock(m_lock);
+    if (m_spares.empty())  return 0;
+    Tab *tableau = m_spares.back();
+    m_spares.pop_back();
+    return tableau;
+  }
+
+  /// Returns a tableau in the same state as p_tableau
+  Tab *Snapshot(const Tab &p_tableau)
+  {
+    Tab *tableau = Acquire();
+    if (tableau) {
+      *tableau = p_tableau;
+      return tableau;
+    }
+    return new Tab(p_tableau);
+  }
+
+  /// Returns a tableau which is no longer needed to the pool
+  void Release(Tab *p_tableau)
+  {
+    if (!p_tableau)  return;
+    if (p_tableau->SharesFactorization()) {
+      delete p_tableau;
+      return;
+    }
+    Gambit::MutexLock lock(m_lock);
+    m_spares.push_back(p_tableau);
+  }
 };
 
 #endif     // LEMKETAB_H
@@ -64,16 +64,26 @@ public:
   /// Perform apivot operation -- outgoing is row, incoming is column
   void Pivot(int outrow, int inlabel);
   long NumPivots(void) const { return T1.NumPivots() + T2.NumPivots(); }
+  long NumTies(void) const { return T1.NumTies() + T2.NumTies(); }
   //@}
 
   /// @name Raw Tableau functions
   //@{
   void Refactor(void) { T1.Refactor(); T2.Refactor(); }
+  /// Moves to the bases of the tableau given, which is for the same game
+  /// but may use different arithmetic
+  template <class U> void SetBasis(const LHTableau<U> &p_tableau)
+  { T1.SetBasis(p_tableau.T1.GetBasis());  T2.SetBasis(p_tableau.T2.GetBasis()); }
+  bool SharesFactorization(void) const
+  { return T1.SharesFactorization() || T2.SharesFactorization(); }
   //@}
   
   /// @name Miscellaneous functions
   //@{
   BFS<T> GetBFS(void);
+  /// Returns true if the bases are complementary, and their solution
+  /// feasible; for exact arithmetic, this certifies an equilibrium
+  bool IsCBFS(void);
 
   int PivotIn(int i);
   int ExitIndex(int i);
@@ -82,6 +92,8 @@ public:
   //@}
 
 protected:
+  template <class U> friend class LHTableau;
+
   LTableau<T> T1,T2;
   Vector<T> tmp1,tmp2; // temporary column vectors, to avoid allocation
   Vector<T> solution;
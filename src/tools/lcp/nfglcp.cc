@@ -23,25 +23,188 @@
 #include <cstdio>
 #include <unistd.h>
 #include <iostream>
+#include <set>
+#include <vector>
 
 #include "libgambit/libgambit.h"
+#include "libgambit/parallel.h"
 #include "nfglcp.h"
 #include "lhtab.h"
 
 using namespace Gambit;
 
+//
+// The floating-point tableau from which the hybrid method follows
+// Lemke paths, together with the matrices it refers to
+//
+class FloatTableau {
+public:
+  Matrix<double> m_A1, m_A2;
+  Vector<double> m_b1, m_b2;
+  LHTableau<double> m_tableau;
+
+  FloatTableau(const Game &p_game)
+    : m_A1(Make_A1<double>(p_game)), m_A2(Make_A2<double>(p_game)),
+      m_b1(Make_b1<double>(p_game)), m_b2(Make_b2<double>(p_game)),
+      m_tableau(m_A1, m_A2, m_b1, m_b2) { }
+};
+
+//
+// The bases visited are recorded in a set which may be queried by the
+// threads following Lemke paths, while new bases are only added on the
+// thread which reports equilibria.
+//
 template <class T>
 class NashLcpStrategySolver<T>::Solution {
+private:
+  std::set<BFS<T> > m_bfsSet;
+  mutable Mutex m_bfsLock;
+
+  Solution(const Solution &);
+  Solution &operator=(const Solution &);
+
 public:
-  List<BFS<T> > m_bfsList;
+  // The equilibria found, which are only counted when streaming
   List<MixedStrategyProfile<T> > m_equilibria;
+  int m_numEquilibria;
+  TableauPool<LHTableau<T> > m_pool;
+  // The floating-point tableau, if the hybrid method is used
+  FloatTableau *m_float;
+
+  Solution(void) : m_numEquilibria(0), m_float(0) { }
+  ~Solution() { delete m_float; }
 
   bool Contains(const BFS<T> &p_bfs) const
-  { return m_bfsList.Contains(p_bfs); }
+  { MutexLock lock(m_bfsLock);  return m_bfsSet.count(p_bfs) > 0; }
   void push_back(const BFS<T> &p_bfs)
-  { m_bfsList.push_back(p_bfs); }
+  { MutexLock lock(m_bfsLock);  m_bfsSet.insert(p_bfs); }
 
-  int EquilibriumCount(void) const { return m_equilibria.size(); }
+  int EquilibriumCount(void) const { return m_numEquilibria; }
+};
+
+//
+// Follows the Lemke path leaving the starting tableau by the label given,
+// on a copy of the starting tableau.
+//
+template <class T> void
+NashLcpStrategySolver<T>::FollowPath(LHTableau<T> &p_path,
+				     const LHTableau<T> &,
+				     int p_label, const Solution &) const
+{
+  p_path.LemkePath(p_label);
+}
+
+//
+// In the hybrid method, the path is followed in floating point, and the
+// copy of the starting tableau is then pivoted in exact arithmetic to the
+// bases at the end of the path.  If these are not certified as a CBFS,
+// the path fails in floating point, or a pivot on it had to break a tie
+// between ratios equal to within the tolerance (so that the exact path
+// may have gone another way), the path is followed again exactly from
+// the start.
+//
+template<> void
+NashLcpStrategySolver<Rational>::FollowPath(LHTableau<Rational> &p_path,
+					    const LHTableau<Rational> &p_start,
+					    int p_label,
+					    const Solution &p_solution) const
+{
+  if (p_solution.m_float) {
+    try {
+      LHTableau<double> approx(p_solution.m_float->m_tableau);
+      approx.SetBasis(p_start);
+      // The path is abandoned at the first tie, which also keeps it from
+      // cycling on ratios which are equal only to within the tolerance
+      long ties = approx.NumTies();
+      int enter = (approx.Member(p_label)) ? -p_label : p_label, exit;
+      do {
+	exit = approx.PivotIn(enter);
+	enter = -exit;
+      } while (exit != p_label && exit != -p_label && 
+	       approx.NumTies() == ties);
+      if (approx.NumTies() == ties) {
+	p_path.SetBasis(approx);
+	if (p_path.IsCBFS())  return;
+      }
+    }
+    catch (Exception &) {
+      // A pivot failed in floating point, or was singular exactly
+    }
+    p_path = p_start;
+  }
+  p_path.LemkePath(p_label);
+}
+
+//
+// The Lemke paths leaving a CBFS, one piece per path.  Paths are followed
+// on any thread, starting from snapshots of the CBFS's tableau; paths
+// ending at a CBFS which has already been visited are dropped right away.
+// Once all the paths have been followed, the search continues from the
+// end of each path in turn, in the order the serial search would visit
+// them, so that equilibria are reported in the same order regardless of
+// the number of threads.  Continuing only then, rather than as each path
+// is finished, leaves the threads free to follow the paths leaving the
+// next CBFS.
+//
+template <class T>
+class NashLcpStrategySolver<T>::BranchTask : public ParallelTask {
+private:
+  const NashLcpStrategySolver<T> &m_solver;
+  const Game &m_game;
+  const LHTableau<T> &m_tableau;
+  Solution &m_solution;
+  int m_depth;
+  std::vector<int> m_labels;
+  std::vector<LHTableau<T> *> m_paths;
+
+public:
+  BranchTask(const NashLcpStrategySolver<T> &p_solver, const Game &p_game,
+	     int j, const LHTableau<T> &p_tableau, Solution &p_solution,
+	     int p_depth)
+    : m_solver(p_solver), m_game(p_game), m_tableau(p_tableau),
+      m_solution(p_solution), m_depth(p_depth)
+  {
+    for (int i = p_tableau.MinCol(); i <= p_tableau.MaxCol(); i++) {
+      if (i != j)  m_labels.push_back(i);
+    }
+    m_paths.resize(m_labels.size(), 0);
+  }
+  virtual ~BranchTask()
+  {
+    for (size_t i = 0; i < m_paths.size(); i++) {
+      m_solution.m_pool.Release(m_paths[i]);
+    }
+  }
+
+  int NumPaths(void) const { return m_labels.size(); }
+
+  void Run(int p_path)
+  {
+    LHTableau<T> *tableau = m_solution.m_pool.Snapshot(m_tableau);
+    try {
+      m_solver.FollowPath(*tableau, m_tableau, m_labels[p_path], m_solution);
+    }
+    catch (...) {
+      m_solution.m_pool.Release(tableau);
+      throw;
+    }
+    if (m_solution.Contains(tableau->GetBFS())) {
+      m_solution.m_pool.Release(tableau);
+      tableau = 0;
+    }
+    m_paths[p_path] = tableau;
+  }
+
+  /// Continues the search from the end of the path
+  void Continue(int p_path)
+  {
+    if (m_paths[p_path]) {
+      m_solver.AllLemke(m_game, m_labels[p_path], *m_paths[p_path],
+			m_solution, m_depth + 1);
+      m_solution.m_pool.Release(m_paths[p_path]);
+      m_paths[p_path] = 0;
+    }
+  }
 };
   
 //
@@ -101,7 +264,10 @@ NashLcpStrategySolver<T>::OnBFS(const Game &p_game,
   }
   
   this->m_onEquilibrium->Render(profile);
-  p_solution.m_equilibria.push_back(profile);
+  p_solution.m_numEquilibria++;
+  if (!this->m_streaming) {
+    p_solution.m_equilibria.push_back(profile);
+  }
 
   if (m_stopAfter > 0 && p_solution.EquilibriumCount() >= m_stopAfter) {
     throw NashEquilibriumLimitReached();
@@ -116,6 +282,8 @@ NashLcpStrategySolver<T>::OnBFS(const Game &p_game,
 // for the equilibria that have already been found.  
 // From each new accessible equilibrium, it follows
 // all possible paths, adding any new equilibria to the List.  
+// The paths leaving an equilibrium are followed in parallel, and the
+// search continues from their ends once all have been followed.
 //
 template <class T> void 
 NashLcpStrategySolver<T>::AllLemke(const Game &p_game,
@@ -132,13 +300,15 @@ NashLcpStrategySolver<T>::AllLemke(const Game &p_game,
   if (depth > 0 && !OnBFS(p_game, B, p_solution)) {
     return;
   }
+  // Paths followed from here would end beyond the maximum depth
+  if (m_maxDepth != 0 && depth + 1 > m_maxDepth) {
+    return;
+  }
   
-  for (int i = B.MinCol(); i <= B.MaxCol(); i++) {
-    if (i != j)  {
-      LHTableau<T> Bcopy(B);
-      Bcopy.LemkePath(i);
-      AllLemke(p_game, i, Bcopy, p_solution, depth+1);
-    }
+  BranchTask task(*this, p_game, j, B, p_solution, depth);
+  RunParallel(task, task.NumPaths(), m_threads);
+  for (int i = 0; i < task.NumPaths(); i++) {
+    task.Continue(i);
   }
 }
 
@@ -159,13 +329,17 @@ NashLcpStrategySolver<T>::Solve(const Game &p_game) const
     Matrix<T> A2 = Make_A2<T>(p_game);
     Vector<T> b2 = Make_b2<T>(p_game);
     LHTableau<T> B(A1, A2, b1, b2);
+    if (m_hybrid) {
+      solution.m_float = new FloatTableau(p_game);
+    }
 
     if (m_stopAfter != 1) {
       AllLemke(p_game, 0, B, solution, 0);
     }
     else  {
-      B.LemkePath(1);
-      OnBFS(p_game, B, solution);
+      LHTableau<T> path(B);
+      FollowPath(path, B, 1, solution);
+      OnBFS(p_game, path, solution);
     }
   }
   catch (NashEquilibriumLimitReached &) {
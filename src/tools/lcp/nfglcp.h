@@ -31,19 +31,30 @@ template <class T> class LHTableau;
 
 template <class T> class NashLcpStrategySolver : public NashStrategySolver<T> {
 public:
+  /// If p_hybrid is true, Lemke paths are followed in floating point,
+  /// and each basis reached is then checked in exact arithmetic; paths
+  /// for which the check fails are followed again exactly.  This is only
+  /// meaningful when T is exact.
   NashLcpStrategySolver(int p_stopAfter, int p_maxDepth,
-			Gambit::shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0)
+			Gambit::shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0,
+			int p_threads = 0, bool p_hybrid = false)
     : NashStrategySolver<T>(p_onEquilibrium),
-      m_stopAfter(p_stopAfter), m_maxDepth(p_maxDepth) { }
+      m_stopAfter(p_stopAfter), m_maxDepth(p_maxDepth),
+      m_threads(p_threads), m_hybrid(p_hybrid) { }
   virtual ~NashLcpStrategySolver()  { }
 
   virtual List<MixedStrategyProfile<T> > Solve(const Game &) const;
 
 private:
-  int m_stopAfter, m_maxDepth;
+  int m_stopAfter, m_maxDepth, m_threads;
+  bool m_hybrid;
 
   class Solution;
+  class BranchTask;
+  friend class BranchTask;
 
+  void FollowPath(LHTableau<T> &, const LHTableau<T> &, int, 
+		  const Solution &) const;
   bool OnBFS(const Game &, LHTableau<T> &, Solution &) const;
   void AllLemke(const Game &, int j, LHTableau<T> &, Solution &, int) const;
 };
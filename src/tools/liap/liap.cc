@@ -48,6 +48,8 @@ void PrintHelp(char *progname)
 
   std::cerr << "Options:\n";
   std::cerr << "  -d DECIMALS      print probabilities with DECIMALS digits\n";
+  std::cerr << "  -B               print equilibria in a binary format, for use\n";
+  std::cerr << "                   by other programs\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -n COUNT         number of starting points to generate\n";
   std::cerr << "  -s FILE          file containing starting points\n";
@@ -134,6 +136,7 @@ int main(int argc, char *argv[])
 {
   opterr = 0;
   bool quiet = false, useStrategic = false, useRandom = false, verbose = false;
+  bool printBinary = false;
   int numTries = 10;
   int maxitsN = 100;
   int numDecimals = 6;
@@ -148,7 +151,7 @@ int main(int argc, char *argv[])
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "d:n:s:hqVvS", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:n:s:hqVvSB", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -167,6 +170,9 @@ int main(int argc, char *argv[])
     case 'S':
       useStrategic = true;
       break;
+    case 'B':
+      printBinary = true;
+      break;
     case 'q':
       quiet = true;
       break;
@@ -218,8 +224,13 @@ int main(int argc, char *argv[])
 
       for (int i = 1; i <= starts.size(); i++) {
 	shared_ptr<StrategyProfileRenderer<double> > renderer;
-	renderer = new MixedStrategyCSVRenderer<double>(std::cout,
-							numDecimals);
+	if (printBinary) {
+	  renderer = new MixedStrategyBinaryRenderer<double>(std::cout);
+	}
+	else {
+	  renderer = new MixedStrategyCSVRenderer<double>(std::cout,
+							  numDecimals);
+	}
 	NashLiapStrategySolver algorithm(maxitsN, verbose, renderer);
 	algorithm.Solve(starts[i]);
       }
@@ -237,8 +248,13 @@ int main(int argc, char *argv[])
 
       for (int i = 1; i <= starts.size(); i++) {
 	shared_ptr<StrategyProfileRenderer<double> > renderer;
-	renderer = new BehavStrategyCSVRenderer<double>(std::cout,
-							numDecimals);
+	if (printBinary) {
+	  renderer = new BehavStrategyBinaryRenderer<double>(std::cout);
+	}
+	else {
+	  renderer = new BehavStrategyCSVRenderer<double>(std::cout,
+							  numDecimals);
+	}
 	NashLiapBehavSolver algorithm(maxitsN, verbose, renderer);
 	algorithm.Solve(starts[i]);
       }
@@ -49,29 +49,49 @@ private:
   double Value(const Vector<double> &) const;
   bool Gradient(const Vector<double> &, Vector<double> &) const;
 
-  double LiapDerivValue(int, int, const MixedStrategyProfile<double> &) const;
+  double LiapDerivValue(int, int, const MixedStrategyProfile<double> &,
+			const Vector<double> &, const Vector<double> &,
+			const Matrix<double> &) const;
 };
 
 double 
 StrategicLyapunovFunction::LiapDerivValue(int i1, int j1,
-					  const MixedStrategyProfile<double> &p) const
+					  const MixedStrategyProfile<double> &p,
+					  const Vector<double> &p_payoffs,
+					  const Vector<double> &p_values,
+					  const Matrix<double> &p_derivs) const
 {
   GameStrategy wrt_strategy = m_game->Players()[i1]->Strategies()[j1];
+  int wrt = j1;
+  for (int i = 1; i < i1; i++) {
+    wrt += m_game->Players()[i]->NumStrategies();
+  }
   double x = 0.0;
-  for (int i = 1; i <= m_game->NumPlayers(); i++)  {
+  for (int i = 1, index = 1; i <= m_game->NumPlayers(); i++)  {
     double psum = 0.0;
     GamePlayer player = m_game->Players()[i];
-    for (int j = 1; j <= player->NumStrategies(); j++)  {
+    // Derivative of player i's payoff with respect to wrt_strategy
+    double deriv = 0.0;
+    if (i == i1) {
+      deriv = p_values[wrt];
+    }
+    else {
+      for (int j = 1, k = index; j <= player->NumStrategies(); j++, k++) {
+	if (p[k] > 0.0) {
+	  deriv += p[k] * p_derivs(k, wrt);
+	}
+      }
+    }
+    for (int j = 1; j <= player->NumStrategies(); j++, index++)  {
       GameStrategy strategy = player->Strategies()[j];
       psum += p[strategy];
-      double x1 = p.GetPayoff(strategy) - p.GetPayoff(i);
+      double x1 = p_values[index] - p_payoffs[i];
       if (i1 == i) {
 	if (x1 > 0.0)
-	  x -= x1 * p.GetPayoffDeriv(i, wrt_strategy);
+	  x -= x1 * deriv;
       }
       else if (x1 > 0.0) {
-	x += x1 * (p.GetPayoffDeriv(i, strategy, wrt_strategy) - 
-		   p.GetPayoffDeriv(i, wrt_strategy));
+	x += x1 * (p_derivs(index, wrt) - deriv);
       }
     }
     if (i == i1)  {
@@ -88,9 +108,15 @@ bool
 StrategicLyapunovFunction::Gradient(const Vector<double> &v, Vector<double> &d) const
 {
   static_cast<Vector<double> &>(m_profile).operator=(v);
+  Vector<double> payoffs(m_game->NumPlayers());
+  Vector<double> values(m_profile.MixedProfileLength());
+  Matrix<double> derivs(m_profile.MixedProfileLength(),
+			m_profile.MixedProfileLength());
+  m_profile.GetPayoffs(payoffs, values);
+  m_profile.GetPayoffDerivs(values, derivs);
   for (int pl = 1, ii = 1; pl <= m_game->NumPlayers(); pl++) {
     for (int st = 1; st <= m_game->Players()[pl]->Strategies().size(); st++) {
-      d[ii++] = LiapDerivValue(pl, st, m_profile);
+      d[ii++] = LiapDerivValue(pl, st, m_profile, payoffs, values, derivs);
     }
   }
   Project(d, m_game->NumStrategies());
@@ -146,7 +172,9 @@ NashLiapStrategySolver::Solve(const MixedStrategyProfile<double> &p_start) const
 
     if (sqrt(gradient.NormSquared()) < .001) {
       this->m_onEquilibrium->Render(p, "NE");
-      solutions.push_back(p);
+      if (!this->m_streaming) {
+	solutions.push_back(p);
+      }
       break;
     }
   }
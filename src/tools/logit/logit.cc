@@ -50,10 +50,17 @@ void PrintHelp(char *progname)
   std::cerr << "  -d DECIMALS      show equilibria as floating point with DECIMALS digits\n";
   std::cerr << "  -s STEP          initial stepsize (default is .03)\n";
   std::cerr << "  -a ACCEL         maximum acceleration (default is 1.1)\n";
+  std::cerr << "  -u STEPS         steps between computations of the Jacobian,\n";
+  std::cerr << "                   approximating it by Broyden updates (default is 0)\n";
   std::cerr << "  -m MAXLAMBDA     stop when reaching MAXLAMBDA (default is 1000000)\n";
   std::cerr << "  -l LAMBDA        compute QRE at `lambda` accurately\n";
   std::cerr << "  -L FILE          compute maximum likelihood estimates;\n";
   std::cerr << "                   read strategy frequencies from FILE\n";
+  std::cerr << "  --batch          with -L, estimate separately for each line of\n";
+  std::cerr << "                   FILE, printing one estimate per line\n";
+  std::cerr << "                   (strategic games, or with -S, only)\n";
+  std::cerr << "  -j THREADS       number of threads to use with --batch (default is\n";
+  std::cerr << "                   the number of processors)\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -e               print only the terminal equilibrium\n";
@@ -89,23 +96,26 @@ int main(int argc, char *argv[])
 {
   opterr = 0;
 
-  bool quiet = false, useStrategic = false;
+  bool quiet = false, useStrategic = false, batch = false;
   double maxLambda = 1000000.0;
   std::string mleFile = "", startFile = "";
   double maxDecel = 1.1;
   double hStart = 0.03;
+  int broydenSteps = 0;
   double targetLambda = -1.0;
   bool fullGraph = true;
   int decimals = 6;
+  int numThreads = 0;
 
   int long_opt_index = 0;
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
     { "version", 0, NULL, 'v'  },
+    { "batch", 0, NULL, 'b'  },
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "d:s:a:m:vqehSL:p:l:", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:s:a:u:m:vqehSL:j:p:l:", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -121,6 +131,9 @@ int main(int argc, char *argv[])
     case 'a':
       maxDecel = atof(optarg);
       break;
+    case 'u':
+      broydenSteps = atoi(optarg);
+      break;
     case 'm':
       maxLambda = atof(optarg);
       break;
@@ -136,6 +149,12 @@ int main(int argc, char *argv[])
     case 'L':
       mleFile = optarg;
       break;
+    case 'b':
+      batch = true;
+      break;
+    case 'j':
+      numThreads = atoi(optarg);
+      break;
     case 'p':
       startFile = optarg;
       break;
@@ -159,6 +178,11 @@ int main(int argc, char *argv[])
     PrintBanner(std::cerr);
   }
 
+  if (batch && mleFile == "") {
+    std::cerr << argv[0] << ": Option --batch requires -L.\n";
+    return 1;
+  }
+
   std::istream* input_stream = &std::cin;
   std::ifstream file_stream;
   if (optind < argc) { 
@@ -174,23 +198,50 @@ int main(int argc, char *argv[])
 
   try {
     Gambit::Array<double> frequencies;
+    Gambit::List<Gambit::Array<double> > batchFrequencies;
     Gambit::Game game = Gambit::ReadGame(*input_stream);
     if (!game->IsPerfectRecall()) {
       throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
     }
+    if (batch && game->IsTree() && !useStrategic) {
+      throw UndefinedException("Batch estimation of extensive games requires -S.");
+    }
 
     if (mleFile != "" && (!game->IsTree() || useStrategic)) {
       frequencies = Gambit::Array<double>(game->MixedProfileLength());
       std::ifstream mleData(mleFile.c_str());
-      ReadProfile(mleData, frequencies);
+      if (batch) {
+	std::string line;
+	while (std::getline(mleData, line)) {
+	  if (line.find_first_not_of(" \t\r") == std::string::npos) {
+	    continue;
+	  }
+	  std::istringstream lineData(line);
+	  ReadProfile(lineData, frequencies);
+	  batchFrequencies.Append(frequencies);
+	}
+      }
+      else {
+	ReadProfile(mleData, frequencies);
+      }
     }
 
     if (!game->IsTree() || useStrategic) {
-      if (startFile == "") {
+      if (batch) {
+	Gambit::MixedStrategyProfile<double> start(game->NewMixedStrategyProfile(0.0));
+	StrategicQREPathTracer tracer(start);
+	tracer.SetMaxDecel(maxDecel);
+	tracer.SetStepsize(hStart);
+	tracer.SetBroydenSteps(broydenSteps);
+	tracer.SetDecimals(decimals);
+	tracer.EstimateStrategicBatch(batchFrequencies, maxLambda, numThreads);
+      }
+      else if (startFile == "") {
 	Gambit::MixedStrategyProfile<double> start(game->NewMixedStrategyProfile(0.0));
 	StrategicQREPathTracer tracer(start);
 	tracer.SetMaxDecel(maxDecel);
 	tracer.SetStepsize(hStart);
+	tracer.SetBroydenSteps(broydenSteps);
 	tracer.SetFullGraph(fullGraph);
 	tracer.SetTargetParam(targetLambda);
 	tracer.SetDecimals(decimals);
@@ -208,6 +259,7 @@ int main(int argc, char *argv[])
 	StrategicQREPathTracer tracer1(start);
 	tracer1.SetMaxDecel(maxDecel);
 	tracer1.SetStepsize(hStart);
+	tracer1.SetBroydenSteps(broydenSteps);
 	tracer1.SetFullGraph(fullGraph);
 	tracer1.SetTargetParam(targetLambda);
 	tracer1.SetDecimals(decimals);
@@ -216,6 +268,7 @@ int main(int argc, char *argv[])
 	StrategicQREPathTracer tracer2(start);
 	tracer2.SetMaxDecel(maxDecel);
 	tracer2.SetStepsize(hStart);
+	tracer2.SetBroydenSteps(broydenSteps);
 	tracer2.SetFullGraph(fullGraph);
 	tracer2.SetTargetParam(targetLambda);
 	tracer2.SetDecimals(decimals);
@@ -228,6 +281,7 @@ int main(int argc, char *argv[])
       AgentQREPathTracer tracer(start);
       tracer.SetMaxDecel(maxDecel);
       tracer.SetStepsize(hStart);
+      tracer.SetBroydenSteps(broydenSteps);
       tracer.SetFullGraph(fullGraph);
       tracer.SetTargetParam(targetLambda);
       tracer.SetDecimals(decimals);
@@ -21,11 +21,15 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <fstream>
+#include <list>
+#include <vector>
 
 #include <libgambit/libgambit.h>
+#include <libgambit/parallel.h>
 using namespace Gambit;
 
 #include "nfglogit.h"
@@ -91,9 +95,13 @@ StrategicQREPathTracer::GetLHS(const Vector<double> &p_point, Vector<double> &p_
     logprofile[i] = p_point[i];
   }
   double lambda = p_point[p_point.Length()];
+  Vector<double> payoffs(game->NumPlayers());
+  Vector<double> values(profile.MixedProfileLength());
+  profile.GetPayoffs(payoffs, values);
   p_lhs = 0.0;
   for (int rowno = 0, pl = 1; pl <= game->NumPlayers(); pl++) {
     GamePlayer player = game->Players()[pl];
+    int firstrow = rowno + 1;
     for (int st = 1; st <= player->Strategies().size(); st++) {
       rowno++;
       if (st == 1) {
@@ -107,8 +115,7 @@ StrategicQREPathTracer::GetLHS(const Vector<double> &p_point, Vector<double> &p_
 	// This is a ratio equation
 	p_lhs[rowno] = (logprofile[player->GetStrategy(st)] - 
 			logprofile[player->GetStrategy(1)] -
-			lambda * (profile.GetPayoff(player->GetStrategy(st)) -
-				  profile.GetPayoff(player->GetStrategy(1))));
+			lambda * (values[rowno] - values[firstrow]));
 
       }
     }
@@ -126,11 +133,16 @@ StrategicQREPathTracer::GetJacobian(const Vector<double> &p_point,
     logprofile[i] = p_point[i];
   }
   double lambda = p_point[p_point.Length()];
+  Vector<double> values(profile.MixedProfileLength());
+  Matrix<double> derivs(profile.MixedProfileLength(),
+			profile.MixedProfileLength());
+  profile.GetPayoffDerivs(values, derivs);
 
   p_matrix = 0.0;
 
   for (int rowno = 0, i = 1; i <= game->NumPlayers(); i++) {
     GamePlayer player = game->Players()[i];
+    int firstrow = rowno + 1;
     for (int j = 1; j <= player->Strategies().size(); j++) {
       rowno++;
       if (j == 1) {
@@ -165,19 +177,12 @@ StrategicQREPathTracer::GetJacobian(const Vector<double> &p_point,
 	    else {
 	      p_matrix(colno, rowno) =
 		-lambda * profile[player2->GetStrategy(m)] *
-		(profile.GetPayoffDeriv(i, 
-					player->GetStrategy(j),
-					player2->GetStrategy(m)) -
-		 profile.GetPayoffDeriv(i, 
-					player->GetStrategy(1),
-					player2->GetStrategy(m)));
+		(derivs(rowno, colno) - derivs(firstrow, colno));
 	    }
 	  }
 	}
 	// Fill the last column, the derivative wrt lambda
-	p_matrix(p_matrix.NumRows(), rowno) =
-	  (profile.GetPayoff(player->GetStrategy(1)) - 
-	   profile.GetPayoff(player->GetStrategy(j)));
+	p_matrix(p_matrix.NumRows(), rowno) = values[firstrow] - values[rowno];
       }
     }
   }
@@ -199,6 +204,208 @@ StrategicQREPathTracer::LogLike(const Array<double> &p_point)
   return ret;
 }
 
+namespace {
+
+//
+// A tracer which records the points on the branch, rather than printing
+// them, together with the orientation in which the branch is followed
+// onwards from each.
+//
+class RecordingTracer : public StrategicQREPathTracer {
+public:
+  RecordingTracer(const StrategicQREPathTracer &p_settings,
+		  const MixedStrategyProfile<double> &p_start);
+
+  void Trace(Vector<double> &p_x, double p_maxLambda, double p_omega)
+  { m_omega = p_omega;  TracePath(p_x, p_maxLambda, m_omega); }
+
+  const std::vector<Vector<double> > &GetPoints(void) const
+  { return m_points; }
+  const std::vector<double> &GetOrientations(void) const
+  { return m_omegas; }
+
+  void PrintPoint(std::ostream &p_stream, const Vector<double> &p_point)
+  { PrintProfile(p_stream, p_point, false); }
+
+protected:
+  void OnStep(const Vector<double> &, bool);
+
+private:
+  double m_omega;
+  std::vector<Vector<double> > m_points;
+  std::vector<double> m_omegas;
+};
+
+RecordingTracer::RecordingTracer(const StrategicQREPathTracer &p_settings,
+				 const MixedStrategyProfile<double> &p_start)
+  : StrategicQREPathTracer(p_start), m_omega(1.0)
+{
+  SetMaxDecel(p_settings.GetMaxDecel());
+  SetStepsize(p_settings.GetStepsize());
+  SetBroydenSteps(p_settings.GetBroydenSteps());
+  SetDecimals(p_settings.GetDecimals());
+}
+
+void RecordingTracer::OnStep(const Vector<double> &p_point, bool p_isTerminal)
+{
+  // The terminal point repeats the last point accepted
+  if (!p_isTerminal) {
+    m_points.push_back(p_point);
+    m_omegas.push_back(m_omega);
+  }
+}
+
+// The log-likelihood of the frequencies at a point on the branch, whose
+// coordinates are the logarithms of the probabilities
+double LogLike(const Array<double> &p_frequencies,
+	       const Vector<double> &p_point)
+{
+  double ret = 0.0;
+  for (int i = 1; i <= p_frequencies.Length(); i++) {
+    ret += p_frequencies[i] * p_point[i];
+  }
+  return ret;
+}
+
+//
+// Estimates for each set of frequencies from the points of a branch
+// already traced.  The points at which the likelihood is greatest
+// among their neighbours bracket a maximum along the branch, which is
+// found by tracing again from the previous point, with the likelihood
+// as the criterion, until the maximum is passed.  The game objects are
+// not shared between threads, so each thread traces using its own copy
+// of the game; these are made beforehand, by the calling thread.
+//
+class EstimationTask : public ParallelTask {
+private:
+  const StrategicQREPathTracer &m_settings;
+  const RecordingTracer &m_branch;
+  const List<Array<double> > &m_frequencies;
+  std::list<Game> m_copies;
+  std::vector<GameRep *> m_spares;
+  std::vector<Vector<double> > m_estimates;
+  Mutex m_lock;
+
+  GameRep *GetGame(void);
+  void ReturnGame(GameRep *);
+
+public:
+  EstimationTask(const StrategicQREPathTracer &p_settings,
+		 const RecordingTracer &p_branch,
+		 const List<Array<double> > &p_frequencies, int p_threads);
+
+  void Run(int p_piece);
+  bool Finish(int p_piece);
+};
+
+EstimationTask::EstimationTask(const StrategicQREPathTracer &p_settings,
+			       const RecordingTracer &p_branch,
+			       const List<Array<double> > &p_frequencies,
+			       int p_threads)
+  : m_settings(p_settings), m_branch(p_branch), m_frequencies(p_frequencies),
+    m_estimates(p_frequencies.Length(),
+		Vector<double>(p_branch.GetPoints()[0].Length()))
+{
+  for (int i = 0; i < p_threads; i++) {
+    m_copies.push_back(m_settings.GetStart().GetGame()->Copy());
+    m_spares.push_back(m_copies.back());
+  }
+}
+
+GameRep *EstimationTask::GetGame(void)
+{
+  MutexLock lock(m_lock);
+  GameRep *game = m_spares.back();
+  m_spares.pop_back();
+  return game;
+}
+
+void EstimationTask::ReturnGame(GameRep *p_game)
+{
+  MutexLock lock(m_lock);
+  m_spares.push_back(p_game);
+}
+
+void EstimationTask::Run(int p_piece)
+{
+  const Array<double> &frequencies = m_frequencies[p_piece + 1];
+  const std::vector<Vector<double> > &points = m_branch.GetPoints();
+  const std::vector<double> &omegas = m_branch.GetOrientations();
+  int last = points[0].Length();
+
+  std::vector<double> logLike(points.size());
+  size_t best = 0;
+  for (size_t k = 0; k < points.size(); k++) {
+    logLike[k] = LogLike(frequencies, points[k]);
+    if (logLike[k] > logLike[best]) {
+      best = k;
+    }
+  }
+  Vector<double> estimate(points[best]);
+  double bestLogLike = logLike[best];
+
+  for (size_t k = 1; k + 1 < points.size(); k++) {
+    if (logLike[k] < logLike[k-1] || logLike[k] <= logLike[k+1]) {
+      continue;
+    }
+    // Should no maximum be found, stop well beyond the bracket
+    double maxLambda = 0.0;
+    for (size_t j = k - 1; j < points.size() && j <= k + 2; j++) {
+      maxLambda = std::max(maxLambda, points[j][last]);
+    }
+
+    GameRep *game = GetGame();
+    {
+      RecordingTracer tracer(m_settings, game->NewMixedStrategyProfile(0.0));
+      tracer.SetMLEFrequencies(frequencies);
+      Vector<double> x(points[k-1]);
+      tracer.Trace(x, 2.0 * maxLambda + 1.0, omegas[k-1]);
+      for (size_t j = 0; j < tracer.GetPoints().size(); j++) {
+	double value = LogLike(frequencies, tracer.GetPoints()[j]);
+	if (value > bestLogLike) {
+	  bestLogLike = value;
+	  estimate = tracer.GetPoints()[j];
+	}
+      }
+    }
+    ReturnGame(game);
+  }
+
+  m_estimates[p_piece] = estimate;
+}
+
+bool EstimationTask::Finish(int p_piece)
+{
+  RecordingTracer printer(m_settings, m_settings.GetStart());
+  printer.SetMLEFrequencies(m_frequencies[p_piece + 1]);
+  printer.PrintPoint(std::cout, m_estimates[p_piece]);
+  return true;
+}
+
+}  // end anonymous namespace
+
+void
+StrategicQREPathTracer::EstimateStrategicBatch(const List<Array<double> > &p_frequencies,
+					       double p_maxLambda, int p_threads)
+{
+  if (p_frequencies.Length() == 0) {
+    return;
+  }
+
+  RecordingTracer branch(*this, m_start);
+  Vector<double> x(m_start.MixedProfileLength() + 1);
+  for (int i = 1; i <= m_start.MixedProfileLength(); i++) {
+    x[i] = log(m_start[i]);
+  }
+  x[x.Length()] = 0.0;
+  branch.Trace(x, p_maxLambda, 1.0);
+
+  int threads = (p_threads > 0) ? p_threads : GetDefaultThreads();
+  threads = std::min(threads, p_frequencies.Length());
+  EstimationTask task(*this, branch, p_frequencies, threads);
+  RunParallel(task, p_frequencies.Length(), threads);
+}
+
 
 //----------------------------------------------------------------------------
 //                StrategicQREPathTracer: Outputting profiles
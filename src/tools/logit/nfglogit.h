@@ -37,6 +37,8 @@ public:
   TraceStrategicPath(const MixedStrategyProfile<double> &p_start,
 		     double p_startLambda, double p_maxLambda, double p_omega);
 
+  const MixedStrategyProfile<double> &GetStart(void) const { return m_start; }
+
   void SetFullGraph(bool p_fullGraph) { m_fullGraph = p_fullGraph; }
   bool GetFullGraph(void) const { return m_fullGraph; }
 
@@ -49,6 +51,15 @@ public:
   
   bool IsMLEMode(void) const { return (m_frequencies.Length() > 0); }
 
+  /// \brief Computes maximum likelihood estimates for many data sets
+  ///
+  /// Traces the principal branch from the starting profile once, and
+  /// then, for each set of observed frequencies, refines the most
+  /// likely points of the traced branch, using up to p_threads threads
+  /// (or the default number if p_threads is not positive).  Prints the
+  /// most likely point found for each set of frequencies, in order.
+  void EstimateStrategicBatch(const List<Array<double> > &p_frequencies,
+			      double p_maxLambda, int p_threads);
 
 protected:
   virtual void OnStep(const Vector<double> &, bool);
@@ -60,9 +71,9 @@ protected:
   // Compute the Jacobian matrix at the specified point.
   virtual void GetJacobian(const Vector<double> &p_point, Matrix<double> &p_matrix);
 
-private:
   void PrintProfile(std::ostream &, const Vector<double> &, bool);
 
+private:
   // Used in maximum likelihood estimation
   double LogLike(const Array<double> &p_point);
 
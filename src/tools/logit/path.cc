@@ -23,23 +23,59 @@
 #include <cmath>
 #include <algorithm>   // for std::max
 #include <iostream>
+#include <vector>
 
 #include <libgambit/libgambit.h>
-#include <libgambit/sqmatrix.h>
 using namespace Gambit;
 
 #include "path.h"
 
 //----------------------------------------------------------------------------
-//                       PathTracer: Auxiliary functions
+//                  QRPathSolver: Dense QR decomposition
 //----------------------------------------------------------------------------
 
 inline double sqr(double x) { return x*x; }
 
-static void Givens(Matrix<double> &b, Matrix<double> &q,
-		   double &c1, double &c2, int l1, int l2, int l3)
+namespace {
+
+//
+// Factors the transposed Jacobian B as Q^T R, by Givens rotations, with
+// Q orthogonal and R upper triangular.  The last row of Q is then the
+// tangent to the path.  Both are stored by rows in contiguous arrays.
+//
+class QRPathSolver : public PathLinearSolver {
+private:
+  int m_rows, m_cols;
+  std::vector<double> m_b, m_q;
+
+  double &B(int r, int c) { return m_b[(r-1) * m_cols + c-1]; }
+  double B(int r, int c) const { return m_b[(r-1) * m_cols + c-1]; }
+  double Q(int r, int c) const { return m_q[(r-1) * m_rows + c-1]; }
+
+  void Givens(double &c1, double &c2, int l1, int l2, int l3);
+
+public:
+  QRPathSolver(int p_rows)
+    : m_rows(p_rows), m_cols(p_rows - 1),
+      m_b(p_rows * (p_rows - 1)), m_q(p_rows * p_rows) { }
+  virtual ~QRPathSolver() { }
+
+  virtual void Factor(Matrix<double> &p_jacobian);
+  virtual void Update(const Vector<double> &p_step,
+		      const Vector<double> &p_change);
+  virtual double NewtonStep(Vector<double> &p_lhs, 
+			    Vector<double> &p_point) const;
+  virtual void GetTangent(Vector<double> &p_tangent) const;
+};
+
+//
+// Rotates rows l1 and l2 of Q, and of R from column l3 onwards, so as to
+// eliminate c2 against c1.  A rotation which would be the identity is
+// skipped, which saves much of the work when the Jacobian is sparse.
+//
+void QRPathSolver::Givens(double &c1, double &c2, int l1, int l2, int l3)
 {
-  if (fabs(c1) + fabs(c2) == 0.0) {
+  if (fabs(c1) + fabs(c2) == 0.0 || (c2 == 0.0 && c1 > 0.0)) {
     return;
   }
 
@@ -53,65 +89,150 @@ static void Givens(Matrix<double> &b, Matrix<double> &q,
   double s1 = c1/sn;
   double s2 = c2/sn;
 
-  for (int k = 1; k <= q.NumColumns(); k++) {
-    double sv1 = q(l1, k);
-    double sv2 = q(l2, k);
-    q(l1, k) = s1 * sv1 + s2 * sv2;
-    q(l2, k) = -s2 * sv1 + s1 * sv2;
+  double *q1 = &m_q[(l1-1) * m_rows], *q2 = &m_q[(l2-1) * m_rows];
+  for (int k = 0; k < m_rows; k++) {
+    double sv1 = q1[k];
+    double sv2 = q2[k];
+    q1[k] = s1 * sv1 + s2 * sv2;
+    q2[k] = -s2 * sv1 + s1 * sv2;
   }
 
-  for (int k = l3; k <= b.NumColumns(); k++) {
-    double sv1 = b(l1, k);
-    double sv2 = b(l2, k);
-    b(l1, k) = s1 * sv1 + s2 * sv2;
-    b(l2, k) = -s2 * sv1 + s1 * sv2;
+  double *b1 = &m_b[(l1-1) * m_cols], *b2 = &m_b[(l2-1) * m_cols];
+  for (int k = l3 - 1; k < m_cols; k++) {
+    double sv1 = b1[k];
+    double sv2 = b2[k];
+    b1[k] = s1 * sv1 + s2 * sv2;
+    b2[k] = -s2 * sv1 + s1 * sv2;
   }
 
   c1 = sn;
   c2 = 0.0;
 }
 
-static void QRDecomp(Matrix<double> &b, Matrix<double> &q)
+void QRPathSolver::Factor(Matrix<double> &p_jacobian)
 {
-  q.MakeIdent();
-  for (int m = 1; m <= b.NumColumns(); m++) {
-    for (int k = m + 1; k <= b.NumRows(); k++) {
-      Givens(b, q, b(m, m), b(k, m), m, k, m + 1);
+  for (int r = 1; r <= m_rows; r++) {
+    for (int c = 1; c <= m_cols; c++) {
+      B(r, c) = p_jacobian(r, c);
+    }
+  }
+  std::fill(m_q.begin(), m_q.end(), 0.0);
+  for (int r = 0; r < m_rows; r++) {
+    m_q[r * m_rows + r] = 1.0;
+  }
+
+  for (int m = 1; m <= m_cols; m++) {
+    for (int k = m + 1; k <= m_rows; k++) {
+      Givens(B(m, m), B(k, m), m, k, m + 1);
     }
   }
 }
 
-static void NewtonStep(Matrix<double> &q, Matrix<double> &b,
-		       Vector<double> &u, Vector<double> &y,
-		       double &d)
+//
+// The transposed Jacobian becomes B + s w^T, where s is the step and
+// w = (change - J s) / (s . s), so that the new Jacobian maps s to the
+// change.  Since B + s w^T = Q^T (R + (Q s) w^T), it suffices to restore
+// R + (Q s) w^T to triangular form, as in section 16.3 of Allgower and
+// Georg, which takes time proportional to the square of the dimension
+// rather than its cube.
+//
+void QRPathSolver::Update(const Vector<double> &p_step,
+			  const Vector<double> &p_change)
 {
-  for (int k = 1; k <= b.NumColumns(); k++) {
+  Vector<double> v(m_rows);
+  double norm = 0.0;
+  for (int r = 1; r <= m_rows; r++) {
+    double s = 0.0;
+    for (int c = 1; c <= m_rows; c++) {
+      s += Q(r, c) * p_step[c];
+    }
+    v[r] = s;
+    norm += p_step[r] * p_step[r];
+  }
+  if (norm == 0.0) {
+    return;
+  }
+
+  // J s = R^T Q s = R^T v
+  Vector<double> w(m_cols);
+  for (int c = 1; c <= m_cols; c++) {
+    double s = 0.0;
+    for (int r = 1; r <= c; r++) {
+      s += B(r, c) * v[r];
+    }
+    w[c] = (p_change[c] - s) / norm;
+  }
+
+  for (int k = m_rows; k >= 2; k--) {
+    Givens(v[k-1], v[k], k-1, k, k-1);
+  }
+  for (int c = 1; c <= m_cols; c++) {
+    B(1, c) += v[1] * w[c];
+  }
+  for (int k = 1; k <= m_cols; k++) {
+    Givens(B(k, k), B(k+1, k), k, k+1, k+1);
+  }
+}
+
+double QRPathSolver::NewtonStep(Vector<double> &y, Vector<double> &u) const
+{
+  for (int k = 1; k <= m_cols; k++) {
     for (int l = 1; l <= k - 1; l++) {
-      y[k] -= b(l, k) * y[l];
+      y[k] -= B(l, k) * y[l];
     }
-    y[k] /= b(k, k);
+    y[k] /= B(k, k);
   }
 
-  d = 0.0;
-  for (int k = 1; k <= b.NumRows(); k++) {
+  double d = 0.0;
+  for (int k = 1; k <= m_rows; k++) {
     double s = 0.0;
-    for (int l = 1; l <= b.NumColumns(); l++) {
-      s += q(l, k) * y[l];
+    for (int l = 1; l <= m_cols; l++) {
+      s += Q(l, k) * y[l];
     }
     u[k] -= s;
     d += s * s;
   }
-  d = sqrt(d);
+  return sqrt(d);
 }
 
+void QRPathSolver::GetTangent(Vector<double> &p_tangent) const
+{
+  for (int c = 1; c <= m_rows; c++) {
+    p_tangent[c] = Q(m_rows, c);
+  }
+}
+
+}  // end anonymous namespace
+
 
 //----------------------------------------------------------------------------
 //             PathTracer: Implementation of path-following engine
 //----------------------------------------------------------------------------
 
+PathLinearSolver *PathTracer::NewLinearSolver(int p_dimension) const
+{
+  return new QRPathSolver(p_dimension);
+}
+
 void 
 PathTracer::TracePath(Vector<double> &x,
 		      double p_maxLambda, double &p_omega)
+{
+  PathLinearSolver *solver = NewLinearSolver(x.Length());
+  try {
+    TracePath(x, p_maxLambda, p_omega, *solver);
+    delete solver;
+  }
+  catch (...) {
+    delete solver;
+    throw;
+  }
+}
+
+void 
+PathTracer::TracePath(Vector<double> &x,
+		      double p_maxLambda, double &p_omega,
+		      PathLinearSolver &p_solver)
 {
   const double c_tol = 1.0e-4;     // tolerance for corrector iteration
   const double c_maxDist = 0.4;    // maximal distance to curve
@@ -129,12 +250,23 @@ PathTracer::TracePath(Vector<double> &x,
   Vector<double> t(x.Length()), newT(x.Length());
   Vector<double> y(x.Length() - 1);
   Matrix<double> b(x.Length(), x.Length() - 1);
-  SquareMatrix<double> q(x.Length());
+
+  // When the Jacobian is approximated by Broyden updates, these hold
+  // the left-hand side at x, and the step to u and the change in the
+  // left-hand side along it
+  Vector<double> lhs(x.Length() - 1), step(x.Length()), change(x.Length() - 1);
+  // The number of steps since the Jacobian was last computed; when the
+  // factorization is not that of a point near x, this is set beyond
+  // m_broydenSteps, so that the Jacobian is computed at the next step
+  int updates = 0;
 
   OnStep(x, false);
   GetJacobian(x, b);
-  QRDecomp(b, q);
-  q.GetRow(q.NumRows(), t);
+  p_solver.Factor(b);
+  p_solver.GetTangent(t);
+  if (m_broydenSteps > 0) {
+    GetLHS(x, lhs);
+  }
   
   while (x[x.Length()] >= 0.0 && x[x.Length()] < p_maxLambda) {
     bool accept = true;
@@ -153,8 +285,19 @@ PathTracer::TracePath(Vector<double> &x,
     }
 
     double decel = 1.0 / m_maxDecel;  // initialize deceleration factor
-    GetJacobian(u, b);
-    QRDecomp(b, q);
+    bool updated = (updates < m_broydenSteps);
+    if (updated) {
+      GetLHS(u, change);
+      change -= lhs;
+      step = u - x;
+      p_solver.Update(step, change);
+      updates++;
+    }
+    else {
+      GetJacobian(u, b);
+      p_solver.Factor(b);
+      updates = 0;
+    }
 
     int iter = 1;
     double disto = 0.0;
@@ -162,7 +305,7 @@ PathTracer::TracePath(Vector<double> &x,
       double dist;
 
       GetLHS(u, y);
-      NewtonStep(q, b, u, y, dist); 
+      dist = p_solver.NewtonStep(y, u); 
 
       if (dist >= c_maxDist) {
 	accept = false;
@@ -196,6 +339,13 @@ PathTracer::TracePath(Vector<double> &x,
     }
 
     if (!accept) {
+      // The factorization is no longer that of a point near x
+      updates = m_broydenSteps + 1;
+      if (updated) {
+	// Retry with the Jacobian computed exactly before reducing the
+	// stepsize, as the approximation may be at fault
+	continue;
+      }
       h /= m_maxDecel;   // PC not accepted; change stepsize and retry
       if (fabs(h) <= c_hmin) {
 	OnStep(x, true);
@@ -215,7 +365,7 @@ PathTracer::TracePath(Vector<double> &x,
     }
 
     // Obtain the tangent at the next step
-    q.GetRow(q.NumRows(), newT); 
+    p_solver.GetTangent(newT);
 
     if (!newton &&
 	Criterion(x, t) * Criterion(u, newT) < 0.0) {
@@ -232,10 +382,6 @@ PathTracer::TracePath(Vector<double> &x,
       h = fabs(h / decel);
     }
 
-    // PC step was successful; update and iterate
-    x = u;
-    OnStep(x, false);
-
     if (t * newT < 0.0) {
       // Bifurcation detected; for now, just "jump over" and continue,
       // taking into account the change in orientation of the curve.
@@ -243,6 +389,14 @@ PathTracer::TracePath(Vector<double> &x,
       p_omega = -p_omega;
     }
     t = newT;
+
+    // PC step was successful; update and iterate.  p_omega is now the
+    // orientation in which to continue from x.
+    x = u;
+    OnStep(x, false);
+    if (m_broydenSteps > 0) {
+      GetLHS(x, lhs);
+    }
   }
 
   OnStep(x, true);
@@ -250,4 +404,3 @@ PathTracer::TracePath(Vector<double> &x,
     x = restart;
   }
 }
-
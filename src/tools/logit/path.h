@@ -25,6 +25,40 @@
 
 using namespace Gambit;
 
+//
+// The linear algebra used in following a path.  The path tracer works
+// with the transpose of the Jacobian, which has one more row than it
+// has columns.  A solver factors this matrix, so that Newton steps and
+// the tangent to the path can be computed from the factorization
+// without refactoring, and can update the factorization when the
+// Jacobian changes by a matrix of rank one.  The default solver uses a
+// dense QR decomposition; tracers for games whose Jacobians have some
+// other structure can supply their own.
+//
+class PathLinearSolver {
+public:
+  virtual ~PathLinearSolver() { }
+
+  /// Factors the transposed Jacobian, which may be overwritten
+  virtual void Factor(Matrix<double> &p_jacobian) = 0;
+  /// \brief Makes a Broyden update of the factorization
+  ///
+  /// Updates the factorization so that the Jacobian it represents maps
+  /// the step p_step to the change p_change in the left-hand side,
+  /// changing the Jacobian by a matrix of rank one.
+  virtual void Update(const Vector<double> &p_step,
+		      const Vector<double> &p_change) = 0;
+  /// \brief Makes a Newton step towards the path
+  ///
+  /// Moves p_point by the Newton step for the left-hand side p_lhs at
+  /// that point, which is overwritten, and returns the length of the
+  /// step.
+  virtual double NewtonStep(Vector<double> &p_lhs, 
+			    Vector<double> &p_point) const = 0;
+  /// Returns the tangent to the path, of unit length
+  virtual void GetTangent(Vector<double> &p_tangent) const = 0;
+};
+
 //
 // This class implements a generic path-following algorithm for smooth curves.
 // It is based on the ideas and codes presented in Allgower and Georg's
@@ -41,8 +75,15 @@ public:
   void SetTargetParam(double p_targetParam) { m_targetParam = p_targetParam; }
   double GetTargetParam(void) const { return m_targetParam; }
 
+  /// Sets the number of steps for which the Jacobian is approximated by
+  /// Broyden updates before it is computed again; if zero (the
+  /// default), the Jacobian is computed at every step
+  void SetBroydenSteps(int p_steps) { m_broydenSteps = p_steps; }
+  int GetBroydenSteps(void) const { return m_broydenSteps; }
+
 protected:
-  PathTracer(void) : m_maxDecel(1.1), m_hStart(0.03), m_targetParam(0.0) 
+  PathTracer(void) : m_maxDecel(1.1), m_hStart(0.03), m_targetParam(0.0),
+		     m_broydenSteps(0)
     { } 
   virtual ~PathTracer() { }
 
@@ -52,7 +93,9 @@ protected:
   virtual double Criterion(const Vector<double> &p_point, 
 			   const Vector<double> &p_tangent) { return -1.0; }
 
-  // Called on each accepted step of the tracing process.
+  // Called on each accepted step of the tracing process.  By then, the
+  // orientation passed to TracePath() is that in which the path is
+  // followed onwards from the point.
   virtual void OnStep(const Vector<double> &, bool) = 0;
 
   // Compute the LHS of the system of equations at the specified point.
@@ -60,8 +103,15 @@ protected:
   // Compute the Jacobian matrix at the specified point.
   virtual void GetJacobian(const Vector<double> &p_point, Matrix<double> &p_matrix) = 0;
 
+  // Create the linear solver for a path in a space of the given dimension.
+  virtual PathLinearSolver *NewLinearSolver(int p_dimension) const;
+
 private:
   double m_maxDecel, m_hStart, m_targetParam;
+  int m_broydenSteps;
+
+  void TracePath(Vector<double> &p_x, double p_maxLambda, double &p_omega,
+		 PathLinearSolver &p_solver);
 };
 
 #endif  // PATH_H
@@ -282,7 +282,9 @@ NashLpBehavSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
 		     p_support.GetGame()->GetRoot(), 1, 1);
     profile.UndefinedToCentroid();
     this->m_onEquilibrium->Render(profile);
-    solution.push_back(profile);
+    if (!this->m_streaming) {
+      solution.push_back(profile);
+    }
   }
   return solution;
 }
@@ -53,6 +53,8 @@ void PrintHelp(char *progname)
   std::cerr << "                   display results with DECIMALS digits\n";
   std::cerr << "  -S               use strategic game\n";
   std::cerr << "  -P               find only subgame-perfect equilibria\n";
+  std::cerr << "  -B               print equilibria in a binary format, for use\n";
+  std::cerr << "                   by other programs\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -v, --version    print version information\n";
@@ -64,7 +66,7 @@ int main(int argc, char *argv[])
   int c;
   int numDecimals = 6;
   bool useFloat = false, useStrategic = false, quiet = false, printDetail = false;
-  bool bySubgames = false;
+  bool bySubgames = false, printBinary = false;
 
   int long_opt_index = 0;
   struct option long_options[] = {
@@ -72,7 +74,7 @@ int main(int argc, char *argv[])
     { "version", 0, NULL, 'v'  },
     { 0,    0,    0,    0   }
   };
-  while ((c = getopt_long(argc, argv, "d:DvqhSP", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:DvqhSPB", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -86,6 +88,9 @@ int main(int argc, char *argv[])
     case 'h':
       PrintHelp(argv[0]);
       break;
+    case 'B':
+      printBinary = true;
+      break;
     case 'q':
       quiet = true;
       break;
@@ -130,7 +135,10 @@ int main(int argc, char *argv[])
     if (!game->IsTree() || useStrategic) {
       if (useFloat) {
 	shared_ptr<StrategyProfileRenderer<double> > renderer;
-	if (printDetail)  {
+	if (printBinary) {
+	  renderer = new MixedStrategyBinaryRenderer<double>(std::cout);
+	}
+	else if (printDetail) {
 	  renderer = new MixedStrategyDetailRenderer<double>(std::cout,
 							     numDecimals);
 	}
@@ -138,17 +146,22 @@ int main(int argc, char *argv[])
 	  renderer = new MixedStrategyCSVRenderer<double>(std::cout, numDecimals);
 	}
 	NashLpStrategySolver<double> algorithm(renderer);
+	algorithm.SetStreaming(true);
 	algorithm.Solve(game);
       }
       else {
 	shared_ptr<StrategyProfileRenderer<Rational> > renderer;
-	if (printDetail) {
+	if (printBinary) {
+	  renderer = new MixedStrategyBinaryRenderer<Rational>(std::cout);
+	}
+	else if (printDetail) {
 	  renderer = new MixedStrategyDetailRenderer<Rational>(std::cout);
 	}
 	else {
 	  renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
 	}
 	NashLpStrategySolver<Rational> algorithm(renderer);
+	algorithm.SetStreaming(true);
 	algorithm.Solve(game);
       }
     }
@@ -156,7 +169,10 @@ int main(int argc, char *argv[])
       if (!bySubgames) {
 	if (useFloat) {
 	  shared_ptr<StrategyProfileRenderer<double> > renderer;
-	  if (printDetail)  {
+	  if (printBinary) {
+	    renderer = new BehavStrategyBinaryRenderer<double>(std::cout);
+	  }
+	  else if (printDetail) {
 	    renderer = new BehavStrategyDetailRenderer<double>(std::cout,
 							       numDecimals);
 	  }
@@ -165,17 +181,22 @@ int main(int argc, char *argv[])
 							    numDecimals);
 	  }
 	  NashLpBehavSolver<double> algorithm(renderer);
+	  algorithm.SetStreaming(true);
 	  algorithm.Solve(game);
 	}
 	else {
 	  shared_ptr<StrategyProfileRenderer<Rational> > renderer;
-	  if (printDetail) {
+	  if (printBinary) {
+	    renderer = new BehavStrategyBinaryRenderer<Rational>(std::cout);
+	  }
+	  else if (printDetail) {
 	    renderer = new BehavStrategyDetailRenderer<Rational>(std::cout);
 	  }
 	  else {
 	    renderer = new BehavStrategyCSVRenderer<Rational>(std::cout);
 	  }
 	  NashLpBehavSolver<Rational> algorithm(renderer);
+	  algorithm.SetStreaming(true);
 	  algorithm.Solve(game);
 	}
       }
@@ -184,7 +205,10 @@ int main(int argc, char *argv[])
 	  shared_ptr<NashBehavSolver<double> > stage = 
 	    new NashLpBehavSolver<double>();
 	  shared_ptr<StrategyProfileRenderer<double> > renderer;
-	  if (printDetail)  {
+	  if (printBinary) {
+	    renderer = new BehavStrategyBinaryRenderer<double>(std::cout);
+	  }
+	  else if (printDetail) {
 	    renderer = new BehavStrategyDetailRenderer<double>(std::cout,
 							       numDecimals);
 	  }
@@ -193,13 +217,17 @@ int main(int argc, char *argv[])
 							    numDecimals);
 	  }
 	  SubgameNashBehavSolver<double> algorithm(stage, renderer);
+	  algorithm.SetStreaming(true);
 	  algorithm.Solve(game);
 	}
 	else {
 	  shared_ptr<NashBehavSolver<Rational> > stage = 
 	    new NashLpBehavSolver<Rational>();
 	  shared_ptr<StrategyProfileRenderer<Rational> > renderer;
-	  if (printDetail)  {
+	  if (printBinary) {
+	    renderer = new BehavStrategyBinaryRenderer<Rational>(std::cout);
+	  }
+	  else if (printDetail) {
 	    renderer = new BehavStrategyDetailRenderer<Rational>(std::cout,
 								 numDecimals);
 	  }
@@ -208,6 +236,7 @@ int main(int argc, char *argv[])
 							      numDecimals);
 	  }
 	  SubgameNashBehavSolver<Rational> algorithm(stage, renderer);
+	  algorithm.SetStreaming(true);
 	  algorithm.Solve(game);
 	}
       }
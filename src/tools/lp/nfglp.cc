@@ -136,7 +136,9 @@ NashLpStrategySolver<T>::Solve(const Game &p_game) const
   }
   this->m_onEquilibrium->Render(eqm);
   List<MixedStrategyProfile<T> > solution;
-  solution.push_back(eqm);
+  if (!this->m_streaming) {
+    solution.push_back(eqm);
+  }
   return solution;
 }
 
@@ -482,15 +482,19 @@ NashSimpdivStrategySolver::State::getlabel(MixedStrategyProfile<Rational> &yy,
   Rational maxz = -1000000;
   ylabel[1] = 1;
   ylabel[2] = 1;
+
+  Vector<Rational> payoffs(yy.GetGame()->NumPlayers());
+  Vector<Rational> values(yy.MixedProfileLength());
+  yy.GetPayoffs(payoffs, values);
   
-  for (int i = 1; i <= yy.GetGame()->NumPlayers(); i++) {
+  for (int i = 1, index = 1; i <= yy.GetGame()->NumPlayers(); i++) {
     GamePlayer player = yy.GetGame()->Players()[i];
     Rational payoff = 0;
     Rational maxval = -1000000;
     int jj = 0;
-    for (int j = 1; j <= player->Strategies().size(); j++) {
-      pay = yy.GetPayoff(player->Strategies()[j]);
-      payoff += yy[player->Strategies()[j]] * pay;
+    for (int j = 1; j <= player->Strategies().size(); j++, index++) {
+      pay = values[index];
+      payoff += yy[index] * pay;
       if (pay > maxval) {
 	maxval = pay;
 	jj = j;
@@ -591,7 +595,9 @@ NashSimpdivStrategySolver::Solve(const MixedStrategyProfile<Rational> &p_start)
     
   this->m_onEquilibrium->Render(y);
   List<MixedStrategyProfile<Rational> > sol;
-  sol.push_back(y);
+  if (!this->m_streaming) {
+    sol.push_back(y);
+  }
   return sol;
 }
 
@@ -612,6 +618,8 @@ void PrintHelp(char *progname)
 
   std::cerr << "Options:\n";
   std::cerr << "  -g MULT          granularity of grid refinement at each step (default is 2)\n";
+  std::cerr << "  -B               print equilibria in a binary format, for use\n";
+  std::cerr << "                   by other programs\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -r DENOM         generate random starting points with denominator DENOM\n";
   std::cerr << "  -n COUNT         number of starting points to generate (requires -r)\n";
@@ -629,7 +637,7 @@ int main(int argc, char *argv[])
   std::string startFile;
   bool useRandom = false;
   int randDenom = 1, gridResize = 2, stopAfter = 1;
-  bool verbose = false, quiet = false;
+  bool verbose = false, quiet = false, printBinary = false;
 
   int long_opt_index = 0;
   struct option long_options[] = {
@@ -639,7 +647,7 @@ int main(int argc, char *argv[])
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "g:hVvn:r:s:d:qS", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "g:hVvn:r:s:d:qSB", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -659,6 +667,9 @@ int main(int argc, char *argv[])
     case 's':
       startFile = optarg;
       break;
+    case 'B':
+      printBinary = true;
+      break;
     case 'q':
       quiet = true;
       break;
@@ -716,7 +727,12 @@ int main(int argc, char *argv[])
     }
     for (int i = 1; i <= starts.size(); i++) {
       shared_ptr<StrategyProfileRenderer<Rational> > renderer;
-      renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
+      if (printBinary) {
+	renderer = new MixedStrategyBinaryRenderer<Rational>(std::cout);
+      }
+      else {
+	renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
+      }
       NashSimpdivStrategySolver algorithm(gridResize, 0, verbose,
 					  renderer);
       algorithm.Solve(starts[i]);